@@ -13,14 +13,16 @@
 #include <Imu.h>
 #include <MotorL.h>
 #include <MotorR.h>
-#include <MotorConfig.h>
+#include <Battery.h>
+#include <Trajectory.h>
 #include <Controller.h>
-using MotorConfig::Vb;
-using Controller::t_ctrl;
+#include <Diagnostics.h>
+#include <LoopSync.h>
+#include <Odometry.h>
 
 // Global Variables
-uint32_t loop_count = 0;	// Control loop counter
-Timer timer;				// Controller timer
+Timer timer;		// Loop execution timer
+float t_loop = 0.0f;	// Previous full loop time [s]
 
 /**
  * @brief Initializes Balbot.
@@ -32,15 +34,12 @@ void setup()
 	Imu::init();
 	MotorL::init();
 	MotorR::init();
+	Battery::init();
+	Trajectory::init();
 	Controller::init();
-
-#if defined(CALIBRATE_IMU)
-
-	// Print IMU calibration values
-	Imu::calibrate();
-	while(1);
-
-#endif
+	Diagnostics::init();
+	LoopSync::init();
+	Odometry::init();
 
 	// Start loop timing
 	timer.start();
@@ -51,63 +50,34 @@ void setup()
  */
 void loop()
 {
-	// Reset loop timer
+	// Wait for synchronised IMU sample
+	LoopSync::wait();
 	timer.reset();
 
 	// Update subsystems
-	Bluetooth::update();
 	Imu::update();
 	MotorL::update();
 	MotorR::update();
+	Battery::update();
+	Trajectory::update();
 	Controller::update();
 
-#if defined(SERIAL_DEBUG)
-
-	// Print debug info to serial
-	MotorL::set_voltage(0.0f);
-	MotorR::set_voltage(0.0f);
-	if (loop_count % 25 == 0)
+	// Send voltage commands to motors
+	if (Diagnostics::get_mode() == Diagnostics::mode_balance)
 	{
-		Serial.println("Motor L Angle [rad]: " + String(MotorL::get_angle(), 2));
-		Serial.println("Motor R Angle [rad]: " + String(MotorR::get_angle(), 2));
-		Serial.println("Pitch Angle [rad]: " + String(Imu::get_pitch(), 2));
-		Serial.println("Voltage L [V]: " + String(Controller::get_motor_L_cmd(), 2));
-		Serial.println("Voltage R [V]: " + String(Controller::get_motor_R_cmd(), 2));
-		Serial.println();
+		MotorL::set_voltage(Controller::get_motor_L_cmd());
+		MotorR::set_voltage(Controller::get_motor_R_cmd());
 	}
-
-#elif defined(MOTOR_SPEED_TEST)
-
-	// Send max motor voltages and print velocities
-	MotorL::set_voltage(MotorConfig::Vb);
-	MotorR::set_voltage(MotorConfig::Vb);
-	if (loop_count % 25 == 0)
+	else
 	{
-		Serial.println("Velocities [rad/s]:");
-		Serial.println("L: " + String(MotorL::get_velocity(), 2));
-		Serial.println("R: " + String(MotorR::get_velocity(), 2));
-		Serial.println();
+		Diagnostics::update(t_loop);
 	}
+	LoopSync::mark_actuation();
 
-#elif defined(GET_MAX_CTRL_FREQ)
-
-	// Estimate maximum possible control frequency
-	const float f_ctrl_max = 1.0f / timer.read();
-	MotorL::set_voltage(0.0f);
-	MotorR::set_voltage(0.0f);
-	Serial.println("GET_MAX_CTRL_FREQ");
-	Serial.println("Max ctrl freq: " + String(f_ctrl_max));
-	while(1);
-
-#else
-
-	// Send voltage commands to motors
-	MotorL::set_voltage(Controller::get_motor_L_cmd());
-	MotorR::set_voltage(Controller::get_motor_R_cmd());
-
-#endif
+	// Update odometry, commands and telemetry off the latency path
+	Odometry::update();
+	Bluetooth::update();
 
-	// Maintain loop timing
-	loop_count++;
-	while (timer.read() < t_ctrl);
+	// Time full loop for Diagnostics
+	t_loop = timer.read();
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+/**
+ * @file Battery.cpp
+ * @author agent
+ */
+#include <Battery.h>
+#include <MotorConfig.h>
+#include <Controller.h>
+#include <CppUtil.h>
+#include <Arduino.h>
+using MotorConfig::Vb;
+using Controller::t_ctrl;
+using CppUtil::clamp;
+
+/**
+ * Namespace Definitions
+ */
+namespace Battery
+{
+	// Sense Circuit Constants
+	// Required divider: Battery+ -- r_top -- A0 -- r_bot -- GND (5V at 20.2V)
+	const uint8_t adc_channel = 0;			// Divider input (A0)
+	const float v_ref = 5.0f;				// ADC reference (AVcc) [V]
+	const float r_top = 10000.0f;			// Divider high-side resistor [Ohm]
+	const float r_bot = 3300.0f;			// Divider low-side resistor [Ohm]
+	const float adc_scale = v_ref / 1024.0f * (r_top + r_bot) / r_bot;
+
+	// Filter Constants
+	const float tau = 0.5f;							// Filter time constant [s]
+	const float alpha = t_ctrl / (tau + t_ctrl);	// Filter gain [per period]
+
+	// Voltage Limits
+	const float v_low = 10.0f;				// Undervoltage threshold [V]
+	const float v_hyst = 0.3f;				// Undervoltage hysteresis [V]
+	const float v_min = 0.5f * Vb;			// Min voltage for scaling [V]
+	const float v_max = 1.2f * Vb;			// Max voltage for scaling [V]
+	const float v_sense_min = 0.5f * Vb;	// Min plausible reading [V]
+	const float v_sense_max = 1.3f * Vb;	// Max plausible reading [V]
+
+	// ISR State
+	const uint8_t adc_count_max = 60;	// Max conversions per sum (no overflow)
+	volatile uint16_t adc_sum = 0;		// Conversion sum [LSB]
+	volatile uint8_t adc_count = 0;		// Conversion count
+
+	// State Variables
+	bool first_frame = true;	// First update flag
+	float voltage = Vb;			// Filtered voltage [V]
+	float v_limit = Vb;			// Usable motor voltage [V]
+	float duty_scale = 1.0f;	// Nominal to usable voltage ratio
+	bool undervolt = false;		// Undervoltage flag
+	bool sensor = false;		// Plausible divider reading flag
+
+	// Init Flag
+	bool init_complete = false;
+
+	// Private Functions
+	void isr_adc();
+}
+
+/**
+ * @brief Starts background ADC conversions
+ * 
+ * Conversions are auto-triggered by Timer0 overflow (~1kHz) and collected
+ * in the ADC ISR, so the control loop never waits on the ADC. Plain
+ * free-running mode would interrupt at ~9.6kHz for no benefit.
+ */
+void Battery::init()
+{
+	if (!init_complete)
+	{
+		// AVcc reference, right-adjusted, battery channel
+		ADMUX = _BV(REFS0) | adc_channel;
+		DIDR0 |= _BV(ADC0D + adc_channel);
+
+		// Auto-trigger on Timer0 overflow with interrupt, 125kHz ADC clock
+		ADCSRB = _BV(ADTS2);
+		ADCSRA = _BV(ADEN) | _BV(ADATE) | _BV(ADIE)
+			| _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+
+		// Set init flag
+		init_complete = true;
+	}
+}
+
+/**
+ * @brief Filters latest conversions and updates voltage limits
+ * 
+ * Readings outside the plausible range (divider not fitted, A0 floating or
+ * battery disconnected) are treated as no sensor. The limits then fall
+ * back to the nominal battery voltage with no duty scaling.
+ */
+void Battery::update()
+{
+	// Collect conversions
+	noInterrupts();
+	const uint16_t sum = adc_sum;
+	const uint8_t count = adc_count;
+	adc_sum = 0;
+	adc_count = 0;
+	interrupts();
+	if (count == 0) return;
+
+	// Reject implausible readings
+	const float v_meas = adc_scale * sum / count;
+	if (v_meas < v_sense_min || v_meas > v_sense_max)
+	{
+		first_frame = true;
+		sensor = false;
+		voltage = Vb;
+		v_limit = Vb;
+		duty_scale = 1.0f;
+		undervolt = false;
+		return;
+	}
+	sensor = true;
+
+	// Low-pass filter voltage
+	if (first_frame)
+	{
+		first_frame = false;
+		voltage = v_meas;
+	}
+	else
+	{
+		voltage += alpha * (v_meas - voltage);
+	}
+
+	// Motor voltage limit and duty scaling
+	v_limit = to_v_limit(voltage);
+	duty_scale = Vb / v_limit;
+
+	// Undervoltage with hysteresis
+	if (voltage < v_low) undervolt = true;
+	else if (voltage > v_low + v_hyst) undervolt = false;
+}
+
+/**
+ * @brief Returns filtered battery voltage [V]
+ */
+float Battery::get_voltage()
+{
+	return voltage;
+}
+
+/**
+ * @brief Returns usable motor voltage limit [V]
+ */
+float Battery::get_v_limit()
+{
+	return v_limit;
+}
+
+/**
+ * @brief Returns usable motor voltage limit at given battery voltage [V]
+ * @param v_bat Battery voltage [V]
+ */
+float Battery::to_v_limit(float v_bat)
+{
+	return clamp(v_bat, v_min, v_max);
+}
+
+/**
+ * @brief Returns ratio of nominal to usable battery voltage
+ * 
+ * Multiplying a voltage command by this ratio before an HBridge built for
+ * MotorConfig::Vb produces the commanded voltage at the actual battery.
+ */
+float Battery::get_duty_scale()
+{
+	return duty_scale;
+}
+
+/**
+ * @brief Returns true if battery is undervoltage
+ */
+bool Battery::is_undervolt()
+{
+	return undervolt;
+}
+
+/**
+ * @brief Returns true if the divider reading is plausible
+ */
+bool Battery::has_sensor()
+{
+	return sensor;
+}
+
+/**
+ * @brief ADC conversion ISR
+ */
+void Battery::isr_adc()
+{
+	if (adc_count < adc_count_max)
+	{
+		adc_sum += ADC;
+		adc_count++;
+	}
+}
+
+/**
+ * @brief ADC conversion complete interrupt
+ */
+ISR(ADC_vect)
+{
+	Battery::isr_adc();
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+/**
+ * @file Battery.h
+ * @brief Subsystem for battery voltage monitoring
+ * @author agent
+ */
+#pragma once
+
+/**
+ * Namespace Declaration
+ */
+namespace Battery
+{
+	void init();
+	void update();
+	float get_voltage();
+	float get_v_limit();
+	float to_v_limit(float v_bat);
+	float get_duty_scale();
+	bool is_undervolt();
+	bool has_sensor();
+}
\ No newline at end of file
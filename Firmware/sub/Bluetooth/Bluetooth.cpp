@@ -5,7 +5,12 @@
 #include <Bluetooth.h>
 #include <Imu.h>
 #include <Controller.h>
+#include <Diagnostics.h>
+#include <Odometry.h>
+#include <Battery.h>
+#include <CppUtil.h>
 #include <SerialStruct.h>
+using CppUtil::clamp;
 
 /**
  * Namespace Definitions
@@ -16,12 +21,33 @@ namespace Bluetooth
 	SerialStruct serial(&Serial);
 	const uint32_t baud = 57600;
 
+	// Command IDs
+	const uint8_t cmd_reset_odom = 0x10;	// Reset odometry pose
+
+	// Status flags
+	const uint8_t flag_undervolt = 0x01;	// Battery undervoltage
+	const uint8_t flag_imu_fault = 0x02;	// IMU fault recovery active
+	const uint8_t flag_no_bat_sense = 0x04;	// Battery reading implausible
+
+	// Battery telemetry scaling
+	const float volt_scale = 10.0f;			// Voltage [1/V]
+
+	// Pose telemetry scaling
+	const float pos_scale = 1000.0f;		// Position [mm/m]
+	const float heading_scale = 10000.0f;	// Heading [1/rad]
+
 	// Received commands
 	float lin_vel_cmd = 0.0f;	// Linear velocity [m/s]
 	float yaw_vel_cmd = 0.0f;	// Yaw velocity [rad/s]
 
 	// Init flag
 	bool init_complete = false;
+
+	// Private Functions
+	void run_cmd(uint8_t cmd);
+	int16_t to_int16(float x);
+	uint8_t to_uint8(uint32_t x);
+	uint8_t get_flags();
 }
 
 /**
@@ -45,17 +71,41 @@ void Bluetooth::init()
 
 /**
  * @brief Checks Bluetooth serial buffer for commands
+ * 
+ * A packet with a NaN linear velocity is a command packet, and its yaw
+ * velocity field holds the command ID. Velocity commands are unchanged.
  */
 void Bluetooth::update()
 {
 	if(Serial.available() >= 8)
 	{
-		serial.rx(lin_vel_cmd);
-		serial.rx(yaw_vel_cmd);
+		float lin_vel_rx, yaw_vel_rx;
+		serial.rx(lin_vel_rx);
+		serial.rx(yaw_vel_rx);
+		if (isnan(lin_vel_rx))
+		{
+			// Ignore IDs that do not fit a byte (including NaN)
+			if (yaw_vel_rx >= 0.0f && yaw_vel_rx < 256.0f)
+			{
+				run_cmd((uint8_t)yaw_vel_rx);
+			}
+		}
+		else
+		{
+			lin_vel_cmd = lin_vel_rx;
+			yaw_vel_cmd = yaw_vel_rx;
+		}
 		serial.tx(Controller::get_lin_vel());
 		serial.tx(Imu::get_yaw_vel());
 		serial.tx(Controller::get_motor_L_cmd());
 		serial.tx(Controller::get_motor_R_cmd());
+		serial.tx(to_int16(pos_scale * Odometry::get_x()));
+		serial.tx(to_int16(pos_scale * Odometry::get_y()));
+		serial.tx(to_int16(heading_scale * Odometry::get_heading()));
+		serial.tx((uint8_t)clamp(volt_scale * Battery::get_voltage(), 0.0f, 255.0f));
+		serial.tx(get_flags());
+		serial.tx(to_uint8(Imu::get_fault_count()));
+		serial.tx(to_uint8(Imu::get_recovery_time()));
 	}
 }
 
@@ -73,4 +123,49 @@ float Bluetooth::get_lin_vel_cmd()
 float Bluetooth::get_yaw_vel_cmd()
 {
 	return yaw_vel_cmd;
+}
+
+/**
+ * @brief Runs command from command packet
+ * 
+ * Command IDs [0x00-0x0F] select Diagnostics modes.
+ */
+void Bluetooth::run_cmd(uint8_t cmd)
+{
+	if (cmd < 0x10)
+	{
+		Diagnostics::set_mode(cmd);
+	}
+	else if (cmd == cmd_reset_odom)
+	{
+		Odometry::reset();
+	}
+}
+
+/**
+ * @brief Rounds and saturates float to int16 for compact telemetry
+ */
+int16_t Bluetooth::to_int16(float x)
+{
+	return (int16_t)lroundf(clamp(x, -32767.0f, 32767.0f));
+}
+
+/**
+ * @brief Saturates unsigned count to uint8 for compact telemetry
+ */
+uint8_t Bluetooth::to_uint8(uint32_t x)
+{
+	return (x > 255) ? 255 : (uint8_t)x;
+}
+
+/**
+ * @brief Returns status flags for telemetry
+ */
+uint8_t Bluetooth::get_flags()
+{
+	uint8_t flags = 0x00;
+	if (Battery::is_undervolt()) flags |= flag_undervolt;
+	if (!Imu::is_ok()) flags |= flag_imu_fault;
+	if (!Battery::has_sensor()) flags |= flag_no_bat_sense;
+	return flags;
 }
\ No newline at end of file
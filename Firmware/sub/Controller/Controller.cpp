@@ -4,12 +4,13 @@
  */
 #include <Controller.h>
 #include <MotorConfig.h>
-#include <Bluetooth.h>
+#include <Trajectory.h>
 #include <Imu.h>
 #include <MotorL.h>
 #include <MotorR.h>
+#include <Battery.h>
+#include <CtrlTable.h>
 #include <CppUtil.h>
-#include <SlewLimiter.h>
 #include <PID.h>
 using MotorConfig::Vb;
 using MotorConfig::Kv;
@@ -70,7 +71,6 @@ namespace Controller
 
 	// Controllers
 	PID yaw_pid(yaw_Kp, yaw_Ki, yaw_Kd, -Vb, Vb, f_ctrl);
-	ClampLimiter volt_limiter(Vb);
 
 	// Init Flag
 	bool init_complete = false;
@@ -84,10 +84,11 @@ void Controller::init()
 	if (!init_complete)
 	{
 		// Init dependent subsystems
-		Bluetooth::init();
+		Trajectory::init();
 		Imu::init();
 		MotorL::init();
 		MotorR::init();
+		Battery::init();
 
 		// Set init flag
 		init_complete = true;
@@ -99,32 +100,62 @@ void Controller::init()
  */
 void Controller::update()
 {
-	// Get teleop commands
-	lin_vel_cmd = Bluetooth::get_lin_vel_cmd();
-	yaw_vel_cmd = Bluetooth::get_yaw_vel_cmd();
+	// Run control with interpolated teleop commands
+	process(
+		Trajectory::get_lin_vel_cmd(),
+		Trajectory::get_yaw_vel_cmd(),
+		Battery::get_v_limit());
+}
+
+/**
+ * @brief Runs one control loop iteration with given commands
+ * @param lin_cmd Linear velocity command [m/s]
+ * @param yaw_cmd Yaw velocity command [rad/s]
+ * @param v_lim Usable motor voltage [V]
+ */
+void Controller::process(float lin_cmd, float yaw_cmd, float v_lim)
+{
+	// Copy commands
+	lin_vel_cmd = lin_cmd;
+	yaw_vel_cmd = yaw_cmd;
 
 	// Estimate linear velocity
 	lin_vel = dr_div_2 * (MotorL::get_velocity() + MotorR::get_velocity());
-	
+
 	// Pitch-Velocity State-Space Control
+	const float pitch = Imu::get_pitch();
+	const float pitch_vel = Imu::get_pitch_vel();
+	const float vel_err = lin_vel_cmd - lin_vel;
 	const float v_avg_ref = Gv * lin_vel_cmd;
-	float v_avg = v_avg_ref
-		+ ss_K1 * (0.0f - Imu::get_pitch_vel())
-		+ ss_K2 * (0.0f - Imu::get_pitch())
-		+ ss_K3 * (lin_vel_cmd - lin_vel);
-	v_avg = clamp(v_avg, -Vb, Vb);
+	const float v_avg_fb =
+		ss_K1 * (0.0f - pitch_vel) +
+		ss_K2 * (0.0f - pitch) +
+		ss_K3 * vel_err;
+	float v_avg = clamp(v_avg_ref + v_avg_fb, -v_lim, v_lim);
+
+	// Explicit MPC correction near voltage limits
+	// Table is solved for |u| <= Vb at zero command, and the model is linear,
+	// so it scales to the headroom left after the velocity feedforward.
+	const float v_ctrl = v_lim - fabsf(v_avg_ref);
+	if (v_ctrl > 0.0f)
+	{
+		const float s_inv = Vb / v_ctrl;
+		v_avg += CtrlTable::lookup(s_inv * pitch, s_inv * pitch_vel, s_inv * v_avg_fb) / s_inv;
+		v_avg = clamp(v_avg, -v_lim, v_lim);
+	}
 
-	// Yaw velocity control
+	// Yaw velocity control (balance takes voltage priority)
 	const float yaw_ff = Gw * yaw_vel_cmd;
 	const float yaw_error = yaw_vel_cmd - Imu::get_yaw_vel();
-	const float v_diff = yaw_pid.update(yaw_error, yaw_ff);
+	const float v_head = v_lim - fabsf(v_avg);
+	const float v_diff = clamp(yaw_pid.update(yaw_error, yaw_ff), -v_head, v_head);
 
 	// Motor voltage commands
-	v_cmd_L = volt_limiter.update(v_avg - v_diff);
-	v_cmd_R = volt_limiter.update(v_avg + v_diff);
+	v_cmd_L = v_avg - v_diff;
+	v_cmd_R = v_avg + v_diff;
 
-	// Disable motors if tipped over
-	if(fabsf(Imu::get_pitch()) > pitch_max)
+	// Disable motors if tipped over or IMU is recovering
+	if(fabsf(pitch) > pitch_max || !Imu::is_ok())
 	{
 		yaw_pid.reset();
 		v_cmd_L = 0.0f;
@@ -132,6 +163,17 @@ void Controller::update()
 	}
 }
 
+/**
+ * @brief Resets controller state
+ */
+void Controller::reset()
+{
+	yaw_pid.reset();
+	lin_vel = 0.0f;
+	v_cmd_L = 0.0f;
+	v_cmd_R = 0.0f;
+}
+
 /**
  * @brief Returns linear velocity estimate [m/s]
  */
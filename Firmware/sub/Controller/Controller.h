@@ -13,10 +13,14 @@ namespace Controller
 	// Fields
 	extern const float f_ctrl;	// Control frequency [Hz]
 	extern const float t_ctrl;	// Control period [s]
+	extern const float dw;		// Wheel to CG Z-axis [m]
+	extern const float dr;		// Wheel radius [m]
 
 	// Methods
 	void init();
 	void update();
+	void process(float lin_cmd, float yaw_cmd, float v_lim);
+	void reset();
 	float get_lin_vel();
 	float get_motor_L_cmd();
 	float get_motor_R_cmd();
@@ -0,0 +1,159 @@
+/**
+ * @file CtrlTable.cpp
+ * @author agent
+ */
+#include <CtrlTable.h>
+#include <avr/pgmspace.h>
+#include <math.h>
+
+/**
+ * Namespace Definitions
+ * 
+ * Gridded explicit MPC solution over (pitch, pitch_vel, u_lin), where u_lin
+ * is the unclamped linear law. Each entry is the first move of the
+ * voltage-constrained MPC minus the clamped linear law [mV], so the table is
+ * zero wherever the linear law is already optimal. The MPC only differs in
+ * a thin band of states just inside the voltage limits, which u_lin spans
+ * with several grid points. The correction is odd in the state, so only
+ * pitch >= 0 is stored, and it is zero at both ends of the u_lin range.
+ * Generated by Host/CtrlTableGen for the model and gains in Controller.cpp
+ * at zero command and full battery voltage.
+ */
+namespace CtrlTable
+{
+	// Grid Constants
+	const uint8_t n_pitch = 5;			// Pitch points (from zero)
+	const uint8_t n_pitch_vel = 11;		// Pitch velocity points
+	const uint8_t n_u_lin = 27;			// Linear law points
+	const float pitch_step = 0.2f;		// Pitch step [rad]
+	const float pitch_vel_min = -10.0f;	// Min pitch velocity [rad/s]
+	const float pitch_vel_step = 2.0f;	// Pitch velocity step [rad/s]
+	const float u_lin_min = -13.0f;		// Min linear law [V]
+	const float u_lin_step = 1.0f;		// Linear law step [V]
+
+	// Correction Table [mV]
+	// Index = (i_pitch * n_pitch_vel + i_pitch_vel) * n_u_lin + i_u_lin
+	#if ES3011_BOT_ID <= 1
+	const bool has_table = false;	// Linear law optimal on whole grid
+	const int16_t table[1] PROGMEM = {0};
+	#else
+	const bool has_table = true;
+	const int16_t table[] PROGMEM =
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 347, 1000, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 49, 465, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 116, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -11, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -116, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -465, -49, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -347, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 212, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 20, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -11, 0,
+		0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -60, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -316, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -852, -224, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -709, -133, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -1557, -589, -75, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -5, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -17, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -192, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -642, -101, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -499, -36, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -1227, -396, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -2000, -1033, -302, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -2000, -2082, -917, -259, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -12, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -107, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -432, -39, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -327, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -917, -236, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -1912, -751, -162, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -2000, -1665, -658, -112, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -2000, -2998, -1419, -566, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -2000, -3000, -2699, -1328, -538, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -50, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -296, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -819, -204, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -676, -113, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -1494, -558, -59, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -2000, -1295, -465, -17, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -2000, -2471, -1141, -394, -2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -2000, -3000, -2190, -1053, -358, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -2000, -3000, -3732, -1944, -965, -322, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, -1000, -2000, -3000, -4000, -3383, -1858, -915, -309, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+	};
+	#endif
+
+	// Private Functions
+	float entry(uint8_t i, uint8_t j, uint8_t k);
+}
+
+/**
+ * @brief Returns constrained correction to linear balance law [V]
+ * @param pitch Pitch angle [rad]
+ * @param pitch_vel Pitch velocity [rad/s]
+ * @param u_lin Unclamped linear law voltage [V]
+ * 
+ * Trilinearly interpolates the table, mirroring negative pitch. Pitch and
+ * pitch velocity are clamped to the grid, and the correction is zero
+ * outside the u_lin range, so the result is continuous everywhere.
+ */
+float CtrlTable::lookup(float pitch, float pitch_vel, float u_lin)
+{
+	if (!has_table) return 0.0f;
+
+	// Mirror negative pitch (correction is odd)
+	float sign = 1.0f;
+	if (pitch < 0.0f)
+	{
+		sign = -1.0f;
+		pitch = -pitch;
+		pitch_vel = -pitch_vel;
+		u_lin = -u_lin;
+	}
+
+	// Grid coordinates
+	const float z = (u_lin - u_lin_min) / u_lin_step;
+	if (!(z >= 0.0f && z <= n_u_lin - 1)) return 0.0f;
+	const float x = fminf(pitch / pitch_step, n_pitch - 1);
+	const float y = fminf(fmaxf((pitch_vel - pitch_vel_min) / pitch_vel_step, 0.0f), n_pitch_vel - 1);
+
+	// Cell indices and fractions
+	const uint8_t i = (uint8_t)fminf(x, n_pitch - 2);
+	const uint8_t j = (uint8_t)fminf(y, n_pitch_vel - 2);
+	const uint8_t k = (uint8_t)fminf(z, n_u_lin - 2);
+	const float fx = x - i;
+	const float fy = y - j;
+	const float fz = z - k;
+
+	// Interpolate along u_lin, pitch_vel, then pitch
+	const float c00 = entry(i, j, k) + fz * (entry(i, j, k + 1) - entry(i, j, k));
+	const float c01 = entry(i, j + 1, k) + fz * (entry(i, j + 1, k + 1) - entry(i, j + 1, k));
+	const float c10 = entry(i + 1, j, k) + fz * (entry(i + 1, j, k + 1) - entry(i + 1, j, k));
+	const float c11 = entry(i + 1, j + 1, k) + fz * (entry(i + 1, j + 1, k + 1) - entry(i + 1, j + 1, k));
+	const float c0 = c00 + fy * (c01 - c00);
+	const float c1 = c10 + fy * (c11 - c10);
+	return sign * 0.001f * (c0 + fx * (c1 - c0));
+}
+
+/**
+ * @brief Returns table entry at given grid indices [mV]
+ */
+float CtrlTable::entry(uint8_t i, uint8_t j, uint8_t k)
+{
+	return (int16_t)pgm_read_word(&table[(i * n_pitch_vel + j) * n_u_lin + k]);
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+/**
+ * @file CtrlTable.h
+ * @brief Namespace for explicit constrained balance controller table
+ * @author agent
+ */
+#pragma once
+
+/**
+ * Namespace Declaration
+ */
+namespace CtrlTable
+{
+	// Methods
+	float lookup(float pitch, float pitch_vel, float u_lin);
+}
\ No newline at end of file
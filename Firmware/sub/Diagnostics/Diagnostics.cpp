@@ -0,0 +1,471 @@
+/**
+ * @file Diagnostics.cpp
+ * @author agent
+ */
+#include <Diagnostics.h>
+#include <Arduino.h>
+#include <Imu.h>
+#include <MotorL.h>
+#include <MotorR.h>
+#include <MotorConfig.h>
+#include <MotorTable.h>
+#include <Battery.h>
+#include <Controller.h>
+#include <LoopSync.h>
+#include <SerialStruct.h>
+#include <CppUtil.h>
+using CppUtil::clamp;
+
+/**
+ * Namespace Definitions
+ */
+namespace Diagnostics
+{
+	// Printing Constants
+	const uint8_t print_div = 25;	// Control periods per print
+
+	// Trace Constants
+	const uint8_t trace_n_in = 13;			// Input floats per trace sample
+	const uint32_t trace_timeout = 1000;	// Input timeout [ms]
+
+	// System ID Constants
+	const uint16_t sysid_ticks = 1500;		// Excitation length [periods]
+	const uint8_t sysid_hold = 3;			// PRBS bit hold [periods]
+	const uint16_t sysid_seed = 0xACE1;		// PRBS LFSR seed
+	const uint16_t sysid_taps = 0xB400;		// PRBS LFSR taps (x^16 + x^14 + x^13 + x^11 + 1)
+	const float sysid_v_off = 6.0f;			// Excitation offset [V]
+	const float sysid_v_amp = 3.0f;			// Excitation amplitude [V]
+
+	// Motor Calibration Constants
+	const uint8_t cal_n_sweeps = 4;			// Sweeps (L fwd, L rev, R fwd, R rev)
+	const float cal_v_step = 0.25f;			// Command voltage step [V]
+	const uint8_t cal_settle = 30;			// Settling periods per step
+	const uint8_t cal_avg = 20;				// Averaging periods per step
+	const float cal_v_moving = 0.1f;		// Min moving effective voltage [V]
+	const float cal_v_table_max = 32.0f;	// Max table command [V]
+
+	// Serial Interface
+	SerialStruct serial(&Serial);
+
+	// State Variables
+	Mode mode = mode_balance;	// Active mode
+	uint8_t print_count = 0;	// Print period counter
+	uint16_t sysid_count = 0;	// System ID period counter
+	uint16_t sysid_lfsr;		// System ID PRBS state
+	uint8_t cal_sweep;			// Calibration sweep index
+	uint8_t cal_step;			// Calibration voltage step
+	uint8_t cal_tick;			// Calibration period in step
+	uint8_t cal_index;			// Next calibration table index
+	float cal_vel_sum;			// Calibration velocity sum [rad/s]
+	float cal_v_prev;			// Previous step command [V]
+	float cal_eff_prev;			// Previous step effective voltage [V]
+	float cal_slope;			// Last step command per effective voltage
+
+	// Init Flag
+	bool init_complete = false;
+
+	// Private Functions
+	void run_serial_debug();
+	void run_motor_speed_test();
+	void run_get_max_ctrl_freq(float t_loop);
+	void run_calibrate_imu();
+	void run_trace();
+	void run_sysid();
+	void run_calibrate_motors();
+	void start_cal_sweep();
+	void print_cal_entry(float v_cmd);
+	void reset_state();
+}
+
+/**
+ * @brief Initializes diagnostics subsystem
+ */
+void Diagnostics::init()
+{
+	if (!init_complete)
+	{
+		// Init dependent subsystems
+		Imu::init();
+		MotorL::init();
+		MotorR::init();
+		Controller::init();
+
+		// Set init flag
+		init_complete = true;
+	}
+}
+
+/**
+ * @brief Runs one iteration of the active diagnostic mode
+ * @param t_loop Time spent in previous full control loop [s]
+ * 
+ * Called in place of the normal motor commands when the mode is not
+ * mode_balance. The controller keeps running, so each handler only decides
+ * what reaches the motors and what gets printed.
+ */
+void Diagnostics::update(float t_loop)
+{
+	switch (mode)
+	{
+		case mode_serial_debug: run_serial_debug(); break;
+		case mode_motor_speed_test: run_motor_speed_test(); break;
+		case mode_get_max_ctrl_freq: run_get_max_ctrl_freq(t_loop); break;
+		case mode_calibrate_imu: run_calibrate_imu(); break;
+		case mode_trace: run_trace(); break;
+		case mode_sysid: run_sysid(); break;
+		case mode_calibrate_motors: run_calibrate_motors(); break;
+		default: break;
+	}
+	if (++print_count >= print_div)
+	{
+		print_count = 0;
+	}
+}
+
+/**
+ * @brief Selects diagnostic mode (invalid modes are ignored)
+ */
+void Diagnostics::set_mode(uint8_t mode_id)
+{
+	if (mode_id < mode_count)
+	{
+		mode = (Mode)mode_id;
+		print_count = 0;
+		sysid_count = 0;
+		sysid_lfsr = sysid_seed;
+		cal_sweep = 0;
+		start_cal_sweep();
+	}
+}
+
+/**
+ * @brief Returns active diagnostic mode
+ */
+Diagnostics::Mode Diagnostics::get_mode()
+{
+	return mode;
+}
+
+/**
+ * @brief Disables motors and prints state to serial
+ */
+void Diagnostics::run_serial_debug()
+{
+	MotorL::set_voltage(0.0f);
+	MotorR::set_voltage(0.0f);
+	if (print_count == 0)
+	{
+		Serial.print(F("Motor L Angle [rad]: "));
+		Serial.println(MotorL::get_angle(), 2);
+		Serial.print(F("Motor R Angle [rad]: "));
+		Serial.println(MotorR::get_angle(), 2);
+		Serial.print(F("Pitch Angle [rad]: "));
+		Serial.println(Imu::get_pitch(), 2);
+		Serial.print(F("Voltage L [V]: "));
+		Serial.println(Controller::get_motor_L_cmd(), 2);
+		Serial.print(F("Voltage R [V]: "));
+		Serial.println(Controller::get_motor_R_cmd(), 2);
+		Serial.print(F("Battery [V]: "));
+		Serial.print(Battery::get_voltage(), 2);
+		Serial.println(Battery::is_undervolt() ? F(" (LOW)") : F(""));
+		Serial.print(F("Latency [us]: "));
+		Serial.print(LoopSync::get_latency(), 0);
+		Serial.print(F(" (max "));
+		Serial.print(LoopSync::get_latency_max(), 0);
+		Serial.println(F(")"));
+		Serial.print(F("Jitter [us]: "));
+		Serial.print(LoopSync::get_jitter_max(), 0);
+		Serial.println(LoopSync::is_synced() ? F(" (synced)") : F(" (unsynced)"));
+		Serial.print(F("IMU faults: "));
+		Serial.print(Imu::get_fault_count());
+		Serial.print(F(" (last recovery "));
+		Serial.print(Imu::get_recovery_time());
+		Serial.println(F(" ms)"));
+		Serial.println();
+	}
+}
+
+/**
+ * @brief Sends max motor voltages and prints velocities
+ */
+void Diagnostics::run_motor_speed_test()
+{
+	MotorL::set_voltage(Battery::get_v_limit());
+	MotorR::set_voltage(Battery::get_v_limit());
+	if (print_count == 0)
+	{
+		Serial.println(F("Velocities [rad/s]:"));
+		Serial.print(F("L: "));
+		Serial.println(MotorL::get_velocity(), 2);
+		Serial.print(F("R: "));
+		Serial.println(MotorR::get_velocity(), 2);
+		Serial.println();
+	}
+}
+
+/**
+ * @brief Prints estimated maximum control frequency and resumes balancing
+ */
+void Diagnostics::run_get_max_ctrl_freq(float t_loop)
+{
+	const float f_ctrl_max = 1.0f / t_loop;
+	MotorL::set_voltage(0.0f);
+	MotorR::set_voltage(0.0f);
+	Serial.println(F("GET_MAX_CTRL_FREQ"));
+	Serial.print(F("Max ctrl freq: "));
+	Serial.println(f_ctrl_max);
+	mode = mode_balance;
+}
+
+/**
+ * @brief Prints IMU calibration values and resumes balancing
+ */
+void Diagnostics::run_calibrate_imu()
+{
+	MotorL::set_voltage(0.0f);
+	MotorR::set_voltage(0.0f);
+	Imu::calibrate();
+	mode = mode_balance;
+}
+
+/**
+ * @brief Replays input traces from serial and resumes balancing
+ * 
+ * Disables the motors and runs each received input sample through the
+ * estimator and controller in place of the hardware readings. Each sample
+ * is 13 floats:
+ * - IMU means: acc_y, acc_z, gyr_x, gyr_x_new, gyr_y, gyr_z
+ * - IMU sampling: t_int, n (see Imu::process)
+ * - Encoders: angle_L, angle_R
+ * - Commands: lin_vel_cmd, yaw_vel_cmd
+ * - Battery: v_bat
+ * 
+ * Each reply is 10 floats:
+ * - Estimates: pitch, pitch_vel, yaw_vel, vel_L, vel_R
+ * - Commands: v_cmd_L, v_cmd_R
+ * - Call times [us]: Imu, MotorL + MotorR, Controller
+ * 
+ * The trace ends on a sample with NaN acc_y or after an input timeout.
+ * All state is reset before and after the trace.
+ */
+void Diagnostics::run_trace()
+{
+	// Disable motors and reset state
+	MotorL::set_voltage(0.0f);
+	MotorR::set_voltage(0.0f);
+	reset_state();
+
+	// Replay samples
+	uint32_t t_rx = millis();
+	while (millis() - t_rx < trace_timeout)
+	{
+		// Wait for full sample
+		if (Serial.available() < 4 * trace_n_in) continue;
+		t_rx = millis();
+
+		// Read sample
+		float acc_y, acc_z, gyr_x, gyr_x_new, gyr_y, gyr_z, t_int, n;
+		float enc_L, enc_R, lin_vel_cmd, yaw_vel_cmd, v_bat;
+		serial.rx(acc_y);
+		serial.rx(acc_z);
+		serial.rx(gyr_x);
+		serial.rx(gyr_x_new);
+		serial.rx(gyr_y);
+		serial.rx(gyr_z);
+		serial.rx(t_int);
+		serial.rx(n);
+		serial.rx(enc_L);
+		serial.rx(enc_R);
+		serial.rx(lin_vel_cmd);
+		serial.rx(yaw_vel_cmd);
+		serial.rx(v_bat);
+		if (isnan(acc_y)) break;
+
+		// Run and time subsystems
+		const uint32_t t0 = micros();
+		Imu::process(acc_y, acc_z, gyr_x, gyr_x_new, gyr_y, gyr_z, t_int, (uint8_t)n);
+		const uint32_t t1 = micros();
+		MotorL::process(enc_L);
+		MotorR::process(enc_R);
+		const uint32_t t2 = micros();
+		Controller::process(lin_vel_cmd, yaw_vel_cmd, Battery::to_v_limit(v_bat));
+		const uint32_t t3 = micros();
+
+		// Send outputs
+		serial.tx(Imu::get_pitch());
+		serial.tx(Imu::get_pitch_vel());
+		serial.tx(Imu::get_yaw_vel());
+		serial.tx(MotorL::get_velocity());
+		serial.tx(MotorR::get_velocity());
+		serial.tx(Controller::get_motor_L_cmd());
+		serial.tx(Controller::get_motor_R_cmd());
+		serial.tx((float)(t1 - t0));
+		serial.tx((float)(t2 - t1));
+		serial.tx((float)(t3 - t2));
+	}
+
+	// Resume balancing from clean state
+	reset_state();
+	mode = mode_balance;
+}
+
+/**
+ * @brief Runs one period of motor system identification
+ * 
+ * Applies the same PRBS voltage to both motors (robot on a stand with the
+ * wheels free), offset positive for the first half and negative for the
+ * second so the motors rarely cross zero speed. Each period streams
+ * 4 floats: excitation [V], L velocity [rad/s], R velocity [rad/s],
+ * battery [V]. Resumes balancing after sysid_ticks periods.
+ */
+void Diagnostics::run_sysid()
+{
+	// Step PRBS every sysid_hold periods
+	if (sysid_count % sysid_hold == 0)
+	{
+		const uint16_t lsb = sysid_lfsr & 0x0001;
+		sysid_lfsr >>= 1;
+		if (lsb) sysid_lfsr ^= sysid_taps;
+	}
+
+	// Excitation voltage
+	const float v_off = (sysid_count < sysid_ticks / 2) ? sysid_v_off : -sysid_v_off;
+	const float v_exc = v_off + ((sysid_lfsr & 0x0001) ? sysid_v_amp : -sysid_v_amp);
+	MotorL::set_voltage_raw(v_exc);
+	MotorR::set_voltage_raw(v_exc);
+
+	// Stream response
+	serial.tx(v_exc);
+	serial.tx(MotorL::get_velocity());
+	serial.tx(MotorR::get_velocity());
+	serial.tx(Battery::get_voltage());
+
+	// Resume balancing when done
+	if (++sysid_count >= sysid_ticks)
+	{
+		MotorL::set_voltage(0.0f);
+		MotorR::set_voltage(0.0f);
+		mode = mode_balance;
+	}
+}
+
+/**
+ * @brief Runs one period of motor linearisation calibration
+ * 
+ * Sweeps the raw voltage on one motor at a time (robot on a stand with the
+ * wheels free) in both directions. At each step the settled speed is mapped
+ * to the effective voltage an ideal motor would need (Kv * speed), and the
+ * commands at which it crosses each MotorTable point are printed as C code
+ * to paste into MotorTable.cpp. Entry 0 is the breakaway command where the
+ * motor starts moving, and points beyond the reachable speed are
+ * extrapolated from the last step. Resumes balancing after all sweeps.
+ */
+void Diagnostics::run_calibrate_motors()
+{
+	// Apply step command to active motor
+	const bool right = cal_sweep >= 2;
+	const float sign = (cal_sweep % 2 == 0) ? +1.0f : -1.0f;
+	const float v_cmd = cal_step * cal_v_step;
+	MotorL::set_voltage_raw(right ? 0.0f : sign * v_cmd);
+	MotorR::set_voltage_raw(right ? sign * v_cmd : 0.0f);
+
+	// Print table header on first period of sweep
+	if (cal_step == 0 && cal_tick == 0)
+	{
+		if (cal_sweep == 0)
+		{
+			Serial.println(F("Motor Table Calibration Code:"));
+			Serial.print(F("#elif ES3011_BOT_ID == "));
+			Serial.println(ES3011_BOT_ID);
+		}
+		Serial.print(F("\tconst int16_t "));
+		Serial.print(cal_sweep % 2 == 0 ? F("fwd_") : F("rev_"));
+		Serial.print(cal_sweep < 2 ? F("L") : F("R"));
+		Serial.print(F("[] PROGMEM = {"));
+	}
+
+	// Average settled velocity
+	cal_tick++;
+	if (cal_tick <= cal_settle) return;
+	cal_vel_sum += sign * (right ? MotorR::get_velocity() : MotorL::get_velocity());
+	if (cal_tick < cal_settle + cal_avg) return;
+
+	// Print commands at crossed table points
+	const float v_eff = MotorConfig::Kv * cal_vel_sum / cal_avg;
+	if (v_eff > cal_eff_prev)
+	{
+		cal_slope = (v_cmd - cal_v_prev) / (v_eff - cal_eff_prev);
+	}
+	while (cal_index < MotorTable::n_pts &&
+		v_eff >= fmaxf(cal_index * MotorTable::v_step, cal_v_moving))
+	{
+		const float v_tgt = cal_index * MotorTable::v_step;
+		const float v_int = cal_v_prev + (v_tgt - cal_eff_prev) * cal_slope;
+		print_cal_entry(clamp(v_int, cal_v_prev, v_cmd));
+	}
+
+	// Advance to next step
+	cal_v_prev = v_cmd;
+	cal_eff_prev = v_eff;
+	cal_vel_sum = 0.0f;
+	cal_tick = 0;
+	cal_step++;
+
+	// Finish sweep (unreachable points extrapolate)
+	if (cal_index >= MotorTable::n_pts || cal_step * cal_v_step > MotorConfig::Vb)
+	{
+		while (cal_index < MotorTable::n_pts)
+		{
+			const float v_tgt = cal_index * MotorTable::v_step;
+			const float v_int = cal_v_prev + (v_tgt - cal_eff_prev) * cal_slope;
+			print_cal_entry(fminf(v_int, cal_v_table_max));
+		}
+		Serial.println(F("};"));
+		if (++cal_sweep < cal_n_sweeps)
+		{
+			start_cal_sweep();
+		}
+		else
+		{
+			Serial.println();
+			MotorL::set_voltage_raw(0.0f);
+			MotorR::set_voltage_raw(0.0f);
+			mode = mode_balance;
+		}
+	}
+}
+
+/**
+ * @brief Resets calibration sweep state
+ */
+void Diagnostics::start_cal_sweep()
+{
+	cal_step = 0;
+	cal_tick = 0;
+	cal_index = 0;
+	cal_vel_sum = 0.0f;
+	cal_v_prev = 0.0f;
+	cal_eff_prev = 0.0f;
+	cal_slope = 1.0f;
+}
+
+/**
+ * @brief Prints next calibration table entry [V] and advances index
+ */
+void Diagnostics::print_cal_entry(float v_cmd)
+{
+	if (cal_index > 0) Serial.print(F(", "));
+	Serial.print(lroundf(1000.0f * v_cmd));
+	cal_index++;
+}
+
+/**
+ * @brief Resets estimator and controller state
+ */
+void Diagnostics::reset_state()
+{
+	Imu::reset();
+	MotorL::reset();
+	MotorR::reset();
+	Controller::reset();
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+/**
+ * @file Diagnostics.h
+ * @brief Subsystem for runtime-selectable diagnostic modes
+ * @author agent
+ */
+#pragma once
+#include <stdint.h>
+
+/**
+ * Namespace Declaration
+ */
+namespace Diagnostics
+{
+	// Diagnostic Modes
+	enum Mode
+	{
+		mode_balance = 0,			// Normal balancing (no diagnostics)
+		mode_serial_debug,			// Disables motors and prints USB serial debug
+		mode_motor_speed_test,		// Commands max motor voltages and prints velocities
+		mode_get_max_ctrl_freq,		// Estimates max control frequency and prints to serial
+		mode_calibrate_imu,			// Calibrates IMU and prints results to serial
+		mode_trace,					// Replays serial input traces through estimator and controller
+		mode_sysid,					// Streams motor response to PRBS voltage excitation
+		mode_calibrate_motors,		// Sweeps motor voltages and prints linearisation tables
+		mode_count
+	};
+
+	// Methods
+	void init();
+	void update(float t_loop);
+	void set_mode(uint8_t mode_id);
+	Mode get_mode();
+}
\ No newline at end of file
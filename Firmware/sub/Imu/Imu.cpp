@@ -6,7 +6,6 @@
 #include <ImuConfig.h>
 #include <MPU6050.h>
 #include <Controller.h>
-#include <DigitalOut.h>
 #include <GRV.h>
 using Controller::t_ctrl;
 
@@ -15,18 +14,64 @@ namespace Imu
 	// IMU Hardware Interface
 	TwoWire* const wire = &Wire;
 	MPU6050 imu(wire);
+	const uint32_t i2c_clock = 400000;	// I2C clock [Hz]
+	const uint32_t i2c_timeout = 1000;	// I2C transaction timeout [us]
+	const uint8_t bus_clear_clocks = 9;	// SCL pulses to release stuck SDA
+
+	// MPU6050 Registers
+	const uint8_t i2c_addr = 0x68;			// I2C address
+	const uint8_t reg_smplrt_div = 0x19;	// Sample rate divider
+	const uint8_t reg_config = 0x1A;		// DLPF config
+	const uint8_t reg_gyro_config = 0x1B;	// Gyro range config
+	const uint8_t reg_accel_config = 0x1C;	// Accel range config
+	const uint8_t reg_fifo_en = 0x23;		// FIFO sensor enable
+	const uint8_t reg_int_pin_cfg = 0x37;	// INT pin config
+	const uint8_t reg_int_enable = 0x38;	// INT source enable
+	const uint8_t reg_user_ctrl = 0x6A;		// FIFO enable and reset
+	const uint8_t reg_pwr_mgmt_1 = 0x6B;	// Power and clock config
+	const uint8_t reg_fifo_count = 0x72;	// FIFO byte count (2 bytes)
+	const uint8_t reg_fifo_r_w = 0x74;		// FIFO data
+
+	// FIFO Constants
+	const float f_sample = 1000.0f;				// Sample rate [Hz]
+	const float t_sample = 1.0f / f_sample;		// Sample period [s]
+	const uint8_t frame_size = 12;				// Accel + gyro bytes per sample
+	const uint8_t frames_per_read = 2;			// Samples per I2C read
+	const uint8_t frames_max = 20;				// Max samples per update
+	const uint8_t frames_new = 2;				// Newest samples for pitch velocity
+	const uint16_t fifo_size = 1024;			// FIFO capacity [bytes]
+
+	// FIFO Scaling
+	uint8_t gyro_config;	// Gyro range register value
+	uint8_t accel_config;	// Accel range register value
+	float acc_scale;		// Accel scale [(m/s^2)/LSB]
+	float gyr_scale;		// Gyro scale [(rad/s)/LSB]
+
+	// Fault State
+	bool configured = false;		// IMU configured at least once
+	bool fault = false;				// Bus or IMU fault active
+	uint16_t fault_count = 0;		// Faults since init
+	uint32_t t_fault = 0;			// Last fault time [ms]
+	uint32_t recovery_time = 0;		// Last recovery time [ms]
 
 	// State Variables
 	bool first_frame = true;
 	GRV pitch, pitch_vel;
 	float yaw_vel;
 
-	// Error LED
-	const uint8_t pin_led = 13;
-	DigitalOut led(pin_led);
-
 	// Init Flag
 	bool init_complete = false;
+
+	// Private Functions
+	void init_wire();
+	bool init_fifo();
+	bool config_imu();
+	bool update_fifo();
+	void set_fault();
+	void recover();
+	void clear_bus();
+	bool write_reg(uint8_t reg, uint8_t val);
+	bool read_regs(uint8_t reg, uint8_t* buf, uint8_t n);
 }
 
 /**
@@ -36,16 +81,14 @@ void Imu::init()
 {
 	if (!init_complete)
 	{
-		// Init I2CC
-		wire->begin();
+		// Init I2C
+		init_wire();
 
-		// Init IMU
-		bool success = imu.init();
-		led = !success;
-		if (!success) while(1);
+		// Init IMU and FIFO oversampling (recovered in update on failure)
 		imu.gyr_x_cal = ImuConfig::gyr_x_cal;
 		imu.gyr_y_cal = ImuConfig::gyr_y_cal;
 		imu.gyr_z_cal = ImuConfig::gyr_z_cal;
+		if (!(imu.init() && init_fifo())) set_fault();
 
 		// Set init flag
 		init_complete = true;
@@ -54,20 +97,59 @@ void Imu::init()
 
 /**
  * @brief Reads IMU and updates state estimates
+ * 
+ * Drains all samples buffered in the IMU FIFO since the last update. Falls
+ * back to a single direct reading if the FIFO is empty or has overflowed.
+ * While faulted, makes one bounded recovery attempt instead.
  */
 void Imu::update()
 {
+	// Recover from bus or IMU fault
+	if (fault)
+	{
+		recover();
+		return;
+	}
+
+	// Try oversampled FIFO update
+	if (update_fifo() || fault) return;
+
 	// Get new readings from IMU
 	imu.update();
-	const float acc_y = imu.get_acc_y();
-	const float acc_z = imu.get_acc_z();
-	const float gyr_x = imu.get_gyr_x();
-	const float gyr_y = imu.get_gyr_y();
-	const float gyr_z = imu.get_gyr_z();
+	if (wire->getWireTimeoutFlag())
+	{
+		set_fault();
+		return;
+	}
+	process(
+		imu.get_acc_y(),
+		imu.get_acc_z(),
+		imu.get_gyr_x(),
+		imu.get_gyr_x(),
+		imu.get_gyr_y(),
+		imu.get_gyr_z(),
+		t_ctrl, 1);
+}
 
+/**
+ * @brief Updates state estimates from mean IMU readings
+ * @param acc_y Mean y-axis acceleration [m/s^2]
+ * @param acc_z Mean z-axis acceleration [m/s^2]
+ * @param gyr_x Mean x-axis angular velocity [rad/s]
+ * @param gyr_x_new Mean of newest x-axis angular velocities [rad/s]
+ * @param gyr_y Mean y-axis angular velocity [rad/s]
+ * @param gyr_z Mean z-axis angular velocity [rad/s]
+ * @param t_int Gyro integration time [s]
+ * @param n Number of averaged samples
+ * 
+ * gyr_x_new is the mean of the newest min(n, 2) samples.
+ */
+void Imu::process(float acc_y, float acc_z, float gyr_x, float gyr_x_new,
+	float gyr_y, float gyr_z, float t_int, uint8_t n)
+{
 	// Estimate pitch from accelerometer
-	GRV grv_acc_y(acc_y, ImuConfig::acc_y_var);
-	GRV grv_acc_z(acc_z, ImuConfig::acc_z_var);
+	GRV grv_acc_y(acc_y, ImuConfig::acc_y_var / n);
+	GRV grv_acc_z(acc_z, ImuConfig::acc_z_var / n);
 	GRV pitch_acc = atan2(grv_acc_y, grv_acc_z);
 
 	// Check special first frame condition
@@ -80,8 +162,9 @@ void Imu::update()
 	else
 	{
 		// Fuse accelerometer and gyro integration
-		pitch_vel = GRV(gyr_x, ImuConfig::gyr_x_var);
-		GRV pitch_gyr = pitch + pitch_vel * t_ctrl;
+		const uint8_t n_new = (n < frames_new) ? n : frames_new;
+		pitch_vel = GRV(gyr_x_new, ImuConfig::gyr_x_var / n_new);
+		GRV pitch_gyr = pitch + GRV(gyr_x, ImuConfig::gyr_x_var / n) * t_int;
 		pitch = fuse(pitch_gyr, pitch_acc);
 	}
 
@@ -91,6 +174,17 @@ void Imu::update()
 		gyr_y * sinf(pitch.mean);
 }
 
+/**
+ * @brief Resets state estimates
+ */
+void Imu::reset()
+{
+	first_frame = true;
+	pitch = GRV();
+	pitch_vel = GRV();
+	yaw_vel = 0.0f;
+}
+
 /**
  * @brief Returns IMU pitch estimate computed via Kalman filter
  */
@@ -115,20 +209,307 @@ float Imu::get_yaw_vel()
 	return yaw_vel;
 }
 
+/**
+ * @brief Returns true if the IMU is responding and estimates are valid
+ * 
+ * Estimates are invalid from a reset (including the one on a fault) until
+ * the first reading after it, since pitch is held at zero until then.
+ */
+bool Imu::is_ok()
+{
+	return !fault && !first_frame;
+}
+
+/**
+ * @brief Returns number of bus or IMU faults since init
+ */
+uint16_t Imu::get_fault_count()
+{
+	return fault_count;
+}
+
+/**
+ * @brief Returns duration of last fault recovery [ms]
+ */
+uint32_t Imu::get_recovery_time()
+{
+	return recovery_time;
+}
+
 /**
  * @brief Calibrates IMU and prints values to Serial
  */
 void Imu::calibrate()
 {
 	imu.calibrate();
-	Serial.println("IMU Calibration Code:");
-	Serial.println("const float gyr_x_cal = " + String(imu.gyr_x_cal, 13) + "f;");
-	Serial.println("const float gyr_y_cal = " + String(imu.gyr_y_cal, 13) + "f;");
-	Serial.println("const float gyr_z_cal = " + String(imu.gyr_z_cal, 13) + "f;");
-	Serial.println("const float gyr_x_var = " + String(imu.get_gyr_x_var(), 14) + "f;");
-	Serial.println("const float gyr_y_var = " + String(imu.get_gyr_y_var(), 14) + "f;");
-	Serial.println("const float gyr_z_var = " + String(imu.get_gyr_z_var(), 14) + "f;");
-	Serial.println("const float acc_x_var = " + String(imu.get_acc_x_var(), 14) + "f;");
-	Serial.println("const float acc_y_var = " + String(imu.get_acc_y_var(), 14) + "f;");
-	Serial.println("const float acc_z_var = " + String(imu.get_acc_z_var(), 14) + "f;");
+	Serial.println(F("IMU Calibration Code:"));
+	Serial.print(F("const float gyr_x_cal = "));
+	Serial.print(imu.gyr_x_cal, 13);
+	Serial.println(F("f;"));
+	Serial.print(F("const float gyr_y_cal = "));
+	Serial.print(imu.gyr_y_cal, 13);
+	Serial.println(F("f;"));
+	Serial.print(F("const float gyr_z_cal = "));
+	Serial.print(imu.gyr_z_cal, 13);
+	Serial.println(F("f;"));
+	Serial.print(F("const float gyr_x_var = "));
+	Serial.print(imu.get_gyr_x_var(), 14);
+	Serial.println(F("f;"));
+	Serial.print(F("const float gyr_y_var = "));
+	Serial.print(imu.get_gyr_y_var(), 14);
+	Serial.println(F("f;"));
+	Serial.print(F("const float gyr_z_var = "));
+	Serial.print(imu.get_gyr_z_var(), 14);
+	Serial.println(F("f;"));
+	Serial.print(F("const float acc_x_var = "));
+	Serial.print(imu.get_acc_x_var(), 14);
+	Serial.println(F("f;"));
+	Serial.print(F("const float acc_y_var = "));
+	Serial.print(imu.get_acc_y_var(), 14);
+	Serial.println(F("f;"));
+	Serial.print(F("const float acc_z_var = "));
+	Serial.print(imu.get_acc_z_var(), 14);
+	Serial.println(F("f;"));
+}
+
+/**
+ * @brief Starts I2C with bounded transaction times
+ * 
+ * Timed-out transactions reset the TWI hardware and set the Wire timeout
+ * flag instead of blocking forever on a stuck bus.
+ */
+void Imu::init_wire()
+{
+	wire->begin();
+	wire->setClock(i2c_clock);
+	wire->setWireTimeout(i2c_timeout, true);
+}
+
+/**
+ * @brief Configures IMU to sample at f_sample into its FIFO
+ * @return True if the IMU acknowledged all writes
+ * 
+ * Keeps the ranges set by the MPU6050 library and derives the raw FIFO
+ * scaling from them, so FIFO and direct readings share units.
+ */
+bool Imu::init_fifo()
+{
+	// Get scaling from configured ranges
+	if (!read_regs(reg_gyro_config, &gyro_config, 1)) return false;
+	if (!read_regs(reg_accel_config, &accel_config, 1)) return false;
+	const uint8_t fs_sel = (gyro_config >> 3) & 0x03;
+	const uint8_t afs_sel = (accel_config >> 3) & 0x03;
+	gyr_scale = (250.0f * (1 << fs_sel) / 32768.0f) * (M_PI / 180.0f);
+	acc_scale = (2.0f * (1 << afs_sel) / 32768.0f) * 9.81f;
+
+	// Write sampling config
+	configured = config_imu();
+	return configured;
+}
+
+/**
+ * @brief Writes full sampling config to IMU registers
+ * @return True if the IMU acknowledged all writes
+ * 
+ * Also restores the wake state and ranges, which are lost if the IMU
+ * resets on a brown-out.
+ */
+bool Imu::config_imu()
+{
+	return
+		// Wake with gyro PLL clock and restore ranges
+		write_reg(reg_pwr_mgmt_1, 0x01) &&
+		write_reg(reg_gyro_config, gyro_config) &&
+		write_reg(reg_accel_config, accel_config) &&
+
+		// 1kHz sampling with 188Hz DLPF
+		write_reg(reg_config, 0x01) &&
+		write_reg(reg_smplrt_div, 0x00) &&
+
+		// Buffer accel and gyro samples in FIFO
+		write_reg(reg_fifo_en, 0x78) &&
+		write_reg(reg_user_ctrl, 0x04) &&
+		write_reg(reg_user_ctrl, 0x40) &&
+
+		// Pulse INT pin high on each new sample
+		write_reg(reg_int_pin_cfg, 0x00) &&
+		write_reg(reg_int_enable, 0x01);
+}
+
+/**
+ * @brief Drains IMU FIFO and updates state estimates
+ * @return True if FIFO samples were used
+ * 
+ * Gyro samples are integrated individually over the control period and
+ * accelerometer samples are averaged. The fused estimate variances shrink
+ * with the number of samples. Pitch velocity uses only the newest gyro
+ * samples, as the mean over the period lags by half a control period.
+ */
+bool Imu::update_fifo()
+{
+	// Read FIFO byte count
+	uint8_t buf[frames_per_read * frame_size];
+	if (!read_regs(reg_fifo_count, buf, 2)) return false;
+	const uint16_t count = ((uint16_t)buf[0] << 8) | buf[1];
+
+	// Empty FIFO with FIFO disabled means the IMU reset (brown-out)
+	const uint16_t n_frames = count / frame_size;
+	if (n_frames == 0)
+	{
+		uint8_t user_ctrl;
+		if (!read_regs(reg_user_ctrl, &user_ctrl, 1)) return false;
+		if (!(user_ctrl & 0x40))
+		{
+			set_fault();
+			return false;
+		}
+	}
+
+	// Reset on empty, misaligned, overflowed, or backlogged FIFO
+	if (n_frames == 0 || n_frames > frames_max ||
+		count % frame_size != 0 || count >= fifo_size - frame_size)
+	{
+		write_reg(reg_user_ctrl, 0x44);
+		return false;
+	}
+
+	// Burst-read and sum samples (and newest x-axis gyro samples)
+	int32_t sum[6] = {0, 0, 0, 0, 0, 0};
+	int32_t gyr_x_new = 0;
+	const uint8_t n_new = (n_frames < frames_new) ? n_frames : frames_new;
+	for (uint8_t f = 0; f < n_frames; f += frames_per_read)
+	{
+		uint8_t n_read = n_frames - f;
+		if (n_read > frames_per_read) n_read = frames_per_read;
+		if (!read_regs(reg_fifo_r_w, buf, n_read * frame_size)) return false;
+		for (uint8_t i = 0; i < n_read * frame_size; i += 2)
+		{
+			const int16_t val = ((uint16_t)buf[i] << 8) | buf[i + 1];
+			const uint8_t axis = (i % frame_size) / 2;
+			sum[axis] += val;
+			if (axis == 3 && f + i / frame_size >= n_frames - n_new)
+			{
+				gyr_x_new += val;
+			}
+		}
+	}
+
+	// Convert sums to calibrated means
+	// sum = [acc_x, acc_y, acc_z, gyr_x, gyr_y, gyr_z]
+	const float n_inv = 1.0f / n_frames;
+	process(
+		acc_scale * n_inv * sum[1],
+		acc_scale * n_inv * sum[2],
+		gyr_scale * n_inv * sum[3] - imu.gyr_x_cal,
+		gyr_scale * gyr_x_new / n_new - imu.gyr_x_cal,
+		gyr_scale * n_inv * sum[4] - imu.gyr_y_cal,
+		gyr_scale * n_inv * sum[5] - imu.gyr_z_cal,
+		n_frames * t_sample, n_frames);
+	return true;
+}
+
+/**
+ * @brief Flags bus or IMU fault and invalidates estimates
+ */
+void Imu::set_fault()
+{
+	if (!fault)
+	{
+		fault = true;
+		fault_count++;
+		t_fault = millis();
+		reset();
+	}
+}
+
+/**
+ * @brief Makes one bounded attempt to recover the bus and IMU
+ * 
+ * Clears the bus and rewrites the IMU config, falling back to the full
+ * library init if the IMU was never configured. Failed attempts cost at
+ * most a few I2C timeouts and are retried on the next update.
+ */
+void Imu::recover()
+{
+	clear_bus();
+	const bool success = configured ? config_imu() : (imu.init() && init_fifo());
+	if (success)
+	{
+		fault = false;
+		recovery_time = millis() - t_fault;
+	}
+}
+
+/**
+ * @brief Releases a stuck I2C bus and restarts Wire
+ * 
+ * A slave interrupted mid-byte can hold SDA low indefinitely. Clocking SCL
+ * until SDA releases and then sending a STOP returns it to idle. Lines are
+ * driven open-drain (output low or released).
+ */
+void Imu::clear_bus()
+{
+	// Release TWI pins
+	wire->end();
+	pinMode(SDA, INPUT);
+	pinMode(SCL, INPUT);
+	digitalWrite(SDA, LOW);
+	digitalWrite(SCL, LOW);
+
+	// Clock out stuck byte
+	for (uint8_t i = 0; i < bus_clear_clocks && !digitalRead(SDA); i++)
+	{
+		pinMode(SCL, OUTPUT);
+		delayMicroseconds(5);
+		pinMode(SCL, INPUT);
+		delayMicroseconds(5);
+	}
+
+	// STOP condition (SDA rises while SCL high)
+	pinMode(SDA, OUTPUT);
+	delayMicroseconds(5);
+	pinMode(SDA, INPUT);
+	delayMicroseconds(5);
+
+	// Restart I2C
+	wire->clearWireTimeoutFlag();
+	init_wire();
+}
+
+/**
+ * @brief Writes value to IMU register
+ * @return True if the write was acknowledged
+ */
+bool Imu::write_reg(uint8_t reg, uint8_t val)
+{
+	wire->beginTransmission(i2c_addr);
+	wire->write(reg);
+	wire->write(val);
+	if (wire->endTransmission() != 0)
+	{
+		set_fault();
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Reads consecutive IMU registers into buffer
+ * @return True if all bytes were read
+ */
+bool Imu::read_regs(uint8_t reg, uint8_t* buf, uint8_t n)
+{
+	wire->beginTransmission(i2c_addr);
+	wire->write(reg);
+	if (wire->endTransmission(false) != 0 ||
+		wire->requestFrom(i2c_addr, n) != n)
+	{
+		set_fault();
+		return false;
+	}
+	for (uint8_t i = 0; i < n; i++)
+	{
+		buf[i] = wire->read();
+	}
+	return true;
 }
\ No newline at end of file
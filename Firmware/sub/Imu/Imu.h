@@ -4,6 +4,7 @@
  * @author Dan Oates (WPI Class of 2020)
  */
 #pragma once
+#include <stdint.h>
 
 /**
  * Namespace Declaration
@@ -12,8 +13,14 @@ namespace Imu
 {
 	void init();
 	void update();
+	void process(float acc_y, float acc_z, float gyr_x, float gyr_x_new,
+		float gyr_y, float gyr_z, float t_int, uint8_t n);
+	void reset();
 	float get_pitch();
 	float get_pitch_vel();
 	float get_yaw_vel();
+	bool is_ok();
+	uint16_t get_fault_count();
+	uint32_t get_recovery_time();
 	void calibrate();
 }
\ No newline at end of file
@@ -0,0 +1,243 @@
+/**
+ * @file LoopSync.cpp
+ * @author agent
+ */
+#include <LoopSync.h>
+#include <Imu.h>
+#include <MotorL.h>
+#include <MotorR.h>
+#include <Controller.h>
+#include <Arduino.h>
+#define LIBCALL_PINCHANGEINT
+#include <PinChangeInt.h>
+#include <math.h>
+using Controller::t_ctrl;
+
+/**
+ * Namespace Definitions
+ */
+namespace LoopSync
+{
+	// Pin Definitions
+	// MPU6050 INT must be wired to pin 11 for synced timing. Without the
+	// wire the pin idles high on its pull-up and periods free-run.
+	const uint8_t pin_int = 11;	// MPU6050 INT (data-ready)
+
+	// Timing Constants
+	const uint8_t samples_per_tick = 10;	// IMU samples per control period
+	const uint32_t t_ctrl_us = (uint32_t)(1e6f * t_ctrl + 0.5f);	// Control period [us]
+	const uint32_t t_sample_us = t_ctrl_us / samples_per_tick;	// IMU sample period [us]
+	const uint32_t t_sample_min = t_sample_us * 4 / 5;	// Min in-rate pulse interval [us]
+	const uint32_t t_sample_max = t_sample_us * 6 / 5;	// Max in-rate pulse interval [us]
+	const uint8_t rate_ok_pulses = samples_per_tick;	// In-rate pulses before trusted
+	const uint32_t t_drdy_timeout = 2000;	// Data-ready timeout [us]
+	const uint8_t stats_ticks = 100;		// Control periods per stats window
+	const float period_gain = 0.01f;		// Mean period filter gain
+	const float period_tol = 0.1f;			// Mean period update tolerance
+
+	// ISR State
+	volatile uint8_t sample_count = 0;	// Samples since last tick
+	volatile uint8_t rate_count = 0;	// Consecutive in-rate pulses
+	volatile uint32_t t_pulse = 0;		// Last pulse time [us]
+	volatile uint32_t t_sample = 0;		// Last trusted sample time [us]
+	volatile uint32_t t_tick = 0;		// Last tick latch time [us]
+	volatile bool tick_ready = false;	// Tick latched flag
+	volatile bool tick_drdy = false;	// Tick latched by data-ready
+
+	// Timing State
+	uint32_t t_tick_prev = 0;	// Previous tick latch time [us]
+	float period_mean = 0.0f;	// Mean synced period [us]
+	bool synced = false;		// Last tick from live data-ready
+
+	// Stats Window
+	uint8_t stats_count = 0;		// Ticks in window
+	uint32_t latency_sum = 0;		// Latency sum [us]
+	uint32_t latency_peak = 0;		// Max latency [us]
+	uint32_t jitter_peak = 0;		// Max period error [us]
+
+	// Published Stats
+	float latency = 0.0f;		// Mean sample-to-PWM latency [us]
+	float latency_max = 0.0f;	// Max sample-to-PWM latency [us]
+	float jitter_max = 0.0f;	// Max period deviation from mean [us]
+
+	// Init Flag
+	bool init_complete = false;
+
+	// Private Functions
+	void isr_drdy();
+	void latch(bool drdy);
+}
+
+/**
+ * @brief Initializes data-ready interrupt
+ */
+void LoopSync::init()
+{
+	if (!init_complete)
+	{
+		// Init dependent subsystems
+		Imu::init();
+		MotorL::init();
+		MotorR::init();
+
+		// Init data-ready interrupt
+		pinMode(pin_int, INPUT_PULLUP);
+		attachPinChangeInterrupt(pin_int, isr_drdy, RISING);
+		t_tick_prev = micros();
+		period_mean = t_ctrl_us;
+
+		// Set init flag
+		init_complete = true;
+	}
+}
+
+/**
+ * @brief Waits for start of next control period
+ * 
+ * Periods start on every samples_per_tick-th IMU data-ready pulse, with
+ * encoder angles latched in the same ISR. Pulses are only trusted after a
+ * run of intervals near the IMU sample period, so noise on an unwired pin
+ * cannot start periods. If trusted pulses stop, the period falls back to
+ * free-running micros() timing.
+ * 
+ * Jitter is measured against the mean synced period rather than t_ctrl, so
+ * a constant MPU6050 clock error does not show up as jitter.
+ */
+void LoopSync::wait()
+{
+	// Wait for data-ready tick or fallback timing
+	bool drdy_lost = false;
+	while (true)
+	{
+		noInterrupts();
+		const uint32_t t_now = micros();
+		drdy_lost = (t_now - t_sample) > t_drdy_timeout;
+		if (!tick_ready && drdy_lost && (t_now - t_tick_prev) >= t_ctrl_us)
+		{
+			latch(false);
+		}
+		if (tick_ready) break;
+		interrupts();
+	}
+
+	// Get tick time and source
+	const uint32_t t = t_tick;
+	const bool drdy = tick_drdy;
+	tick_ready = false;
+	interrupts();
+	synced = drdy && !drdy_lost;
+
+	// Period jitter about mean synced period (overruns excluded from mean)
+	const float period = t - t_tick_prev;
+	const float period_err = period - period_mean;
+	if (synced && fabsf(period_err) < period_tol * period_mean)
+	{
+		period_mean += period_gain * period_err;
+	}
+	const uint32_t jitter = (uint32_t)fabsf(period_err);
+	if (jitter > jitter_peak) jitter_peak = jitter;
+	t_tick_prev = t;
+}
+
+/**
+ * @brief Records sample-to-PWM latency after motor commands are sent
+ */
+void LoopSync::mark_actuation()
+{
+	// Latency since tick latch
+	const uint32_t lat = micros() - t_tick_prev;
+	latency_sum += lat;
+	if (lat > latency_peak) latency_peak = lat;
+
+	// Publish window stats
+	if (++stats_count >= stats_ticks)
+	{
+		latency = (float)latency_sum / stats_count;
+		latency_max = latency_peak;
+		jitter_max = jitter_peak;
+		stats_count = 0;
+		latency_sum = 0;
+		latency_peak = 0;
+		jitter_peak = 0;
+	}
+}
+
+/**
+ * @brief Returns mean sample-to-PWM latency over last window [us]
+ */
+float LoopSync::get_latency()
+{
+	return latency;
+}
+
+/**
+ * @brief Returns max sample-to-PWM latency over last window [us]
+ */
+float LoopSync::get_latency_max()
+{
+	return latency_max;
+}
+
+/**
+ * @brief Returns max control period deviation over last window [us]
+ */
+float LoopSync::get_jitter_max()
+{
+	return jitter_max;
+}
+
+/**
+ * @brief Returns true if last period was started by data-ready
+ * 
+ * False if data-ready pulses have stopped, even if the period was latched
+ * by a data-ready pulse before they stopped.
+ */
+bool LoopSync::is_synced()
+{
+	return synced;
+}
+
+/**
+ * @brief IMU data-ready ISR
+ * 
+ * Counts only pulses that follow a run of rate_ok_pulses intervals within
+ * tolerance of the IMU sample period.
+ */
+void LoopSync::isr_drdy()
+{
+	// Check pulse rate
+	const uint32_t t = micros();
+	const uint32_t dt = t - t_pulse;
+	t_pulse = t;
+	if (dt < t_sample_min || dt > t_sample_max)
+	{
+		rate_count = 0;
+		return;
+	}
+	if (rate_count < rate_ok_pulses)
+	{
+		rate_count++;
+		return;
+	}
+
+	// Count trusted sample
+	t_sample = t;
+	if (++sample_count >= samples_per_tick)
+	{
+		latch(true);
+	}
+}
+
+/**
+ * @brief Latches tick time and encoder angles (interrupts disabled)
+ * @param drdy True if latched by data-ready pulse
+ */
+void LoopSync::latch(bool drdy)
+{
+	sample_count = 0;
+	t_tick = micros();
+	tick_drdy = drdy;
+	MotorL::latch();
+	MotorR::latch();
+	tick_ready = true;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+/**
+ * @file LoopSync.h
+ * @brief Subsystem for IMU data-ready synchronised loop timing
+ * @author agent
+ */
+#pragma once
+
+/**
+ * Namespace Declaration
+ */
+namespace LoopSync
+{
+	void init();
+	void wait();
+	void mark_actuation();
+	float get_latency();
+	float get_latency_max();
+	float get_jitter_max();
+	bool is_synced();
+}
\ No newline at end of file
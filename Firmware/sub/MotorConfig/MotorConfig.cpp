@@ -10,10 +10,9 @@
 namespace MotorConfig
 {
 	// Universal Constants
-	const float Vb = 12.0f;		// Battery voltage [V]
+	const float Vb = 12.0f;		// Nominal battery voltage [V]
 	const float i_ST = 1.0f;	// Stall current [A]
 	const float i_NL = 0.12f;	// No-load current [A]
-	const float R = 5.4f;		// Resistance [Ohm]
 
 	// Robot-Specific Constants
 	// direction = Motor direction [+1, -1]
@@ -26,9 +25,20 @@ namespace MotorConfig
 		const float tr = +56.0f;
 	#endif
 
+	// Fitted Motor Constants [see Matlab/balbot_sysid.m]
+	// R = Resistance [Ohm]
+	// w_NL = No-load speed [rad/s]
+	// t_ST = Stall torque [N*m]
+	#if ES3011_BOT_ID > 20
+		#error Must define ES3011_BOT_ID in range [0, 20]
+	#else
+		// Not fitted (derived from tr)
+		const float R = 5.4f;
+		const float w_NL = 1047.0f / tr;
+		const float t_ST = 0.015f * tr;
+	#endif
+
 	// Derived Constants
-	const float w_NL = 1047.0f / tr;			// No-load speed [rad/s]
-	const float t_ST = 0.015f * tr;				// Stall torque [N*m]
 	const float Kv = (Vb - R * i_NL) / w_NL;	// Voltage constant [V/(rad/s)]
 	const float Kt = t_ST * R / Vb;				// Torque constant [N*m/A]
 	const float enc_cpr = 44.0 * tr;			// Encoder resolution [cnt/rev]
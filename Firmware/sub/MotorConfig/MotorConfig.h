@@ -10,7 +10,7 @@
  */
 namespace MotorConfig
 {
-	const extern float Vb;			// Battery voltage [V]
+	const extern float Vb;			// Nominal battery voltage [V]
 	const extern float R;			// Resistance [Ohm]
 	const extern float Kv;			// Voltage constant [V/(rad/s)]
 	const extern float Kt;			// Torque constant [N*m/A]
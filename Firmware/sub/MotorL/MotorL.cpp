@@ -4,8 +4,10 @@
  */
 #include <MotorL.h>
 #include <MotorConfig.h>
+#include <MotorTable.h>
 #include <Controller.h>
 #include <Imu.h>
+#include <Battery.h>
 #include <HBridge.h>
 #include <QuadEncoder.h>
 #include <LTIFilter.h>
@@ -39,8 +41,10 @@ namespace MotorL
 	LTIFilter angle_diff = LTIFilter::make_dif(f_ctrl);
 
 	// State Variables
-	float angle;		// Encoder angle [rad]
-	float velocity;		// Angular velocity [rad/s]
+	volatile float angle_latch = 0.0f;	// Latched encoder angle [rad]
+	float angle;						// Encoder angle [rad]
+	float velocity;						// Angular velocity [rad/s]
+	bool diff_seed = true;				// Differentiator needs seeding
 
 	// Init Flag
 	bool init_complete = false;
@@ -73,20 +77,74 @@ void MotorL::init()
 }
 
 /**
- * @brief Updates motor state estimates
+ * @brief Latches encoder angle for next update
+ * 
+ * Called from the LoopSync data-ready ISR so the encoder snapshot matches
+ * the IMU sample instant.
+ */
+void MotorL::latch()
+{
+	angle_latch = encoder.get_angle();
+}
+
+/**
+ * @brief Updates motor state estimates from latched encoder angle
  */
 void MotorL::update()
 {
-	angle = MotorConfig::direction * encoder.get_angle() - Imu::get_pitch();
+	noInterrupts();
+	const float enc_angle = angle_latch;
+	interrupts();
+	process(enc_angle);
+}
+
+/**
+ * @brief Updates motor state estimates from given encoder angle [rad]
+ * 
+ * The first update after a reset, and the first after the IMU estimates
+ * become valid again, only seed the differentiator with the current angle.
+ * Otherwise the reset pitch in the wheel angle would spike the velocity.
+ */
+void MotorL::process(float enc_angle)
+{
+	angle = MotorConfig::direction * enc_angle - Imu::get_pitch();
 	velocity = angle_diff.update(angle);
+	if (diff_seed || !Imu::is_ok()) velocity = 0.0f;
+	diff_seed = !Imu::is_ok();
 }
 
 /**
- * @brief Sends given voltage command to motor
+ * @brief Resets motor state estimates
+ */
+void MotorL::reset()
+{
+	angle_diff = LTIFilter::make_dif(f_ctrl);
+	angle = 0.0f;
+	velocity = 0.0f;
+	diff_seed = true;
+}
+
+/**
+ * @brief Sends given effective voltage command to motor
+ * 
+ * Passes the command through the calibrated linearisation table so the
+ * motor responds like the ideal model assumed by the controller.
  */
 void MotorL::set_voltage(float v_cmd)
 {
-	motor.set_voltage(MotorConfig::direction * v_cmd);
+	set_voltage_raw(MotorTable::lookup(
+		MotorTable::fwd_L, MotorTable::rev_L, v_cmd));
+}
+
+/**
+ * @brief Sends given voltage command to motor without linearisation
+ * 
+ * Scales the command by the measured battery voltage so the applied
+ * voltage does not sag as the battery drains.
+ */
+void MotorL::set_voltage_raw(float v_cmd)
+{
+	motor.set_voltage(MotorConfig::direction * Battery::get_duty_scale() * v_cmd);
 }
 
 /**
@@ -11,8 +11,12 @@
 namespace MotorL
 {
 	void init();
+	void latch();
 	void update();
+	void process(float enc_angle);
+	void reset();
 	void set_voltage(float v_cmd);
+	void set_voltage_raw(float v_cmd);
 	float get_angle();
 	float get_velocity();
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+ * @file MotorTable.cpp
+ * @author agent
+ */
+#include <MotorTable.h>
+
+/**
+ * Namespace Definitions
+ * 
+ * Entry i > 0 of each table is the H-bridge command [mV] that spins the
+ * motor at the steady speed of an ideal motor driven at i * v_step volts,
+ * which compensates driver deadband, friction and duty-to-voltage
+ * non-linearity. Entry 0 is the breakaway command, so any non-zero effective
+ * voltage starts the motor. Generate per-robot tables with the Diagnostics
+ * calibrate_motors mode and add its #elif block above the defaults.
+ */
+namespace MotorTable
+{
+	const uint8_t n_pts = 25;
+	const float v_step = 0.5f;
+
+#if ES3011_BOT_ID > 20
+#error Must define ES3011_BOT_ID in range [0, 20]
+#else
+	// Not calibrated (identity)
+	const int16_t fwd_L[] PROGMEM = {0, 500, 1000, 1500, 2000, 2500, 3000, 3500, 4000, 4500, 5000, 5500, 6000, 6500, 7000, 7500, 8000, 8500, 9000, 9500, 10000, 10500, 11000, 11500, 12000};
+	const int16_t rev_L[] PROGMEM = {0, 500, 1000, 1500, 2000, 2500, 3000, 3500, 4000, 4500, 5000, 5500, 6000, 6500, 7000, 7500, 8000, 8500, 9000, 9500, 10000, 10500, 11000, 11500, 12000};
+	const int16_t fwd_R[] PROGMEM = {0, 500, 1000, 1500, 2000, 2500, 3000, 3500, 4000, 4500, 5000, 5500, 6000, 6500, 7000, 7500, 8000, 8500, 9000, 9500, 10000, 10500, 11000, 11500, 12000};
+	const int16_t rev_R[] PROGMEM = {0, 500, 1000, 1500, 2000, 2500, 3000, 3500, 4000, 4500, 5000, 5500, 6000, 6500, 7000, 7500, 8000, 8500, 9000, 9500, 10000, 10500, 11000, 11500, 12000};
+#endif
+}
+
+/**
+ * @brief Returns linearised motor command [V]
+ * @param fwd Forward table [PROGMEM]
+ * @param rev Reverse table [PROGMEM]
+ * @param v_eff Desired effective voltage [V]
+ * 
+ * Interpolates linearly between table points and extrapolates the last
+ * segment beyond the table. Zero maps to zero, and any other command is at
+ * least the breakaway command of its direction.
+ */
+float MotorTable::lookup(const int16_t* fwd, const int16_t* rev, float v_eff)
+{
+	if (v_eff == 0.0f) return 0.0f;
+
+	// Select direction
+	const int16_t* table = (v_eff >= 0.0f) ? fwd : rev;
+	const float x = fabsf(v_eff) / v_step;
+
+	// Interpolate segment
+	uint8_t i = (uint8_t)fminf(x, n_pts - 2);
+	const float y0 = (int16_t)pgm_read_word(&table[i]);
+	const float y1 = (int16_t)pgm_read_word(&table[i + 1]);
+	const float v_cmd = 0.001f * (y0 + (x - i) * (y1 - y0));
+	return (v_eff >= 0.0f) ? v_cmd : -v_cmd;
+}
\ No newline at end of file
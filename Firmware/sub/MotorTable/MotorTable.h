@@ -0,0 +1,24 @@
+/**
+ * @file MotorTable.h
+ * @brief Namespace for motor actuator linearisation tables
+ * @author agent
+ */
+#pragma once
+#include <Arduino.h>
+
+/**
+ * Namespace Declaration
+ */
+namespace MotorTable
+{
+	// Fields
+	const extern uint8_t n_pts;				// Table points per direction
+	const extern float v_step;				// Effective voltage step [V]
+	extern const int16_t fwd_L[] PROGMEM;	// Left forward commands [mV]
+	extern const int16_t rev_L[] PROGMEM;	// Left reverse commands [mV]
+	extern const int16_t fwd_R[] PROGMEM;	// Right forward commands [mV]
+	extern const int16_t rev_R[] PROGMEM;	// Right reverse commands [mV]
+
+	// Methods
+	float lookup(const int16_t* fwd, const int16_t* rev, float v_eff);
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+/**
+ * @file Odometry.cpp
+ * @author agent
+ */
+#include <Odometry.h>
+#include <ImuConfig.h>
+#include <Controller.h>
+#include <Imu.h>
+#include <MotorL.h>
+#include <MotorR.h>
+#include <GRV.h>
+using Controller::t_ctrl;
+using Controller::dr;
+using Controller::dw;
+
+/**
+ * Namespace Definitions
+ */
+namespace Odometry
+{
+	// Geometry Constants
+	const float dr_div_2 = dr / 2.0f;			// Half wheel radius [m]
+	const float yaw_per_rad = dr / (2.0f * dw);	// Yaw per wheel angle difference [rad/rad]
+
+	// Yaw Fusion Constants
+	const float enc_yaw_var = 0.001f;		// Encoder yaw velocity variance [(rad/s)^2]
+	const float bias_yaw_max = 0.05f;		// Max encoder yaw velocity for bias tracking [rad/s]
+	const float bias_gain = 0.002f;			// Gyro bias tracking gain [per period]
+
+	// State Variables
+	bool first_frame = true;	// First update flag
+	float angle_L_prev;			// Previous left wheel angle [rad]
+	float angle_R_prev;			// Previous right wheel angle [rad]
+	float gyr_bias = 0.0f;		// Gyro yaw velocity bias [rad/s]
+	float x = 0.0f;				// X position [m]
+	float y = 0.0f;				// Y position [m]
+	float heading = 0.0f;		// Heading [rad]
+
+	// Init Flag
+	bool init_complete = false;
+}
+
+/**
+ * @brief Initializes odometry subsystem
+ */
+void Odometry::init()
+{
+	if (!init_complete)
+	{
+		// Init dependent subsystems
+		Imu::init();
+		MotorL::init();
+		MotorR::init();
+
+		// Set init flag
+		init_complete = true;
+	}
+}
+
+/**
+ * @brief Integrates wheel and gyro motion into pose
+ * 
+ * Heading rate fuses the gyro and the encoder wheel speed difference.
+ * While the encoders report almost no turning, their difference to the
+ * gyro is tracked as gyro bias so the heading does not drift at rest or
+ * on straight runs.
+ */
+void Odometry::update()
+{
+	// Wheel angle increments
+	const float angle_L = MotorL::get_angle();
+	const float angle_R = MotorR::get_angle();
+	if (first_frame)
+	{
+		first_frame = false;
+		angle_L_prev = angle_L;
+		angle_R_prev = angle_R;
+		return;
+	}
+	const float del_L = angle_L - angle_L_prev;
+	const float del_R = angle_R - angle_R_prev;
+	angle_L_prev = angle_L;
+	angle_R_prev = angle_R;
+
+	// Yaw velocity from encoders and gyro
+	const float yaw_vel_enc = yaw_per_rad * (del_R - del_L) / t_ctrl;
+	const float yaw_vel_gyr = Imu::get_yaw_vel();
+	if (fabsf(yaw_vel_enc) < bias_yaw_max)
+	{
+		gyr_bias += bias_gain * (yaw_vel_gyr - yaw_vel_enc - gyr_bias);
+	}
+
+	// Fuse yaw velocities
+	GRV grv_yaw_enc(yaw_vel_enc, enc_yaw_var);
+	GRV grv_yaw_gyr(yaw_vel_gyr - gyr_bias, ImuConfig::gyr_z_var);
+	const float del_heading = fuse(grv_yaw_enc, grv_yaw_gyr).mean * t_ctrl;
+
+	// Integrate pose at mid-period heading
+	const float del_dist = dr_div_2 * (del_L + del_R);
+	const float heading_mid = heading + 0.5f * del_heading;
+	x += del_dist * cosf(heading_mid);
+	y += del_dist * sinf(heading_mid);
+
+	// Wrap heading to [-pi, +pi]
+	heading += del_heading;
+	if (heading > M_PI) heading -= 2.0f * M_PI;
+	else if (heading < -M_PI) heading += 2.0f * M_PI;
+}
+
+/**
+ * @brief Resets pose to origin (gyro bias estimate is kept)
+ */
+void Odometry::reset()
+{
+	first_frame = true;
+	x = 0.0f;
+	y = 0.0f;
+	heading = 0.0f;
+}
+
+/**
+ * @brief Returns X position [m]
+ */
+float Odometry::get_x()
+{
+	return x;
+}
+
+/**
+ * @brief Returns Y position [m]
+ */
+float Odometry::get_y()
+{
+	return y;
+}
+
+/**
+ * @brief Returns heading [rad]
+ */
+float Odometry::get_heading()
+{
+	return heading;
+}
\ No newline at end of file
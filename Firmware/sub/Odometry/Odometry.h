@@ -0,0 +1,19 @@
+/**
+ * @file Odometry.h
+ * @brief Subsystem for wheel and gyro odometry
+ * @author agent
+ */
+#pragma once
+
+/**
+ * Namespace Declaration
+ */
+namespace Odometry
+{
+	void init();
+	void update();
+	void reset();
+	float get_x();
+	float get_y();
+	float get_heading();
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * @file Trajectory.cpp
+ * @author agent
+ */
+#include <Trajectory.h>
+#include <Bluetooth.h>
+#include <Controller.h>
+#include <CppUtil.h>
+#include <math.h>
+using Controller::t_ctrl;
+using CppUtil::clamp;
+
+/**
+ * Namespace Definitions
+ */
+namespace Trajectory
+{
+	// Velocity caps are mirrored in Matlab/balbot_teleop.m, which scales
+	// joystick commands to them. The host does no shaping of its own.
+
+	// Linear Velocity Limits
+	const float lin_vel_max = 0.8f;		// Max velocity [m/s]
+	const float lin_acc_max = 0.8f;		// Max acceleration [m/s^2]
+	const float lin_jrk_max = 4.0f;		// Max jerk [m/s^3]
+
+	// Yaw Velocity Limits
+	const float yaw_vel_max = 1.6f;		// Max velocity [rad/s]
+	const float yaw_acc_max = 8.0f;		// Max acceleration [rad/s^2]
+	const float yaw_jrk_max = 80.0f;	// Max jerk [rad/s^3]
+
+	// State Variables
+	float lin_vel = 0.0f;	// Linear velocity command [m/s]
+	float lin_acc = 0.0f;	// Linear acceleration command [m/s^2]
+	float yaw_vel = 0.0f;	// Yaw velocity command [rad/s]
+	float yaw_acc = 0.0f;	// Yaw acceleration command [rad/s^2]
+
+	// Init Flag
+	bool init_complete = false;
+
+	// Private Functions
+	void interpolate(float vel_tgt, float& vel, float& acc,
+		float acc_max, float jrk_max);
+}
+
+/**
+ * @brief Initializes trajectory generator
+ */
+void Trajectory::init()
+{
+	if (!init_complete)
+	{
+		// Init dependent subsystems
+		Bluetooth::init();
+
+		// Set init flag
+		init_complete = true;
+	}
+}
+
+/**
+ * @brief Advances velocity trajectories one control period
+ * 
+ * Velocity targets from Bluetooth are treated as sparse setpoints. The
+ * commands passed to the controller approach them with bounded acceleration
+ * and jerk, so the host may update them far below the control frequency.
+ */
+void Trajectory::update()
+{
+	const float lin_tgt = clamp(
+		Bluetooth::get_lin_vel_cmd(), -lin_vel_max, lin_vel_max);
+	const float yaw_tgt = clamp(
+		Bluetooth::get_yaw_vel_cmd(), -yaw_vel_max, yaw_vel_max);
+	interpolate(lin_tgt, lin_vel, lin_acc, lin_acc_max, lin_jrk_max);
+	interpolate(yaw_tgt, yaw_vel, yaw_acc, yaw_acc_max, yaw_jrk_max);
+}
+
+/**
+ * @brief Returns linear velocity command [m/s]
+ */
+float Trajectory::get_lin_vel_cmd()
+{
+	return lin_vel;
+}
+
+/**
+ * @brief Returns yaw velocity command [rad/s]
+ */
+float Trajectory::get_yaw_vel_cmd()
+{
+	return yaw_vel;
+}
+
+/**
+ * @brief Steps jerk-limited velocity profile toward target
+ * @param vel_tgt Target velocity
+ * @param vel Profile velocity (updated)
+ * @param acc Profile acceleration (updated)
+ * @param acc_max Max acceleration magnitude
+ * @param jrk_max Max jerk magnitude
+ * 
+ * Commands the largest acceleration from which the profile can still ramp
+ * back to zero acceleration exactly at the target under the jerk limit. The
+ * braking curve is solved for the discrete profile, where ramping down from
+ * acceleration a in steps of d = jrk_max * t_ctrl covers a * (a + d) / (2 *
+ * jrk_max) of velocity including the current period.
+ */
+void Trajectory::interpolate(float vel_tgt, float& vel, float& acc,
+	float acc_max, float jrk_max)
+{
+	// Finish in one period if that stays within the jerk limit
+	const float acc_del = jrk_max * t_ctrl;
+	const float vel_err = vel_tgt - vel;
+	const float acc_fin = vel_err / t_ctrl;
+	if (fabsf(acc_fin) <= acc_del && fabsf(acc_fin - acc) <= acc_del)
+	{
+		vel = vel_tgt;
+		acc = acc_fin;
+		return;
+	}
+
+	// Acceleration command on discrete braking curve
+	const float acc_half = 0.5f * acc_del;
+	float acc_tgt = sqrtf(acc_half * acc_half +
+		2.0f * jrk_max * fabsf(vel_err)) - acc_half;
+	acc_tgt = clamp(acc_tgt, 0.0f, acc_max);
+	if (vel_err < 0.0f) acc_tgt = -acc_tgt;
+
+	// Jerk-limited acceleration and velocity integration
+	acc += clamp(acc_tgt - acc, -acc_del, acc_del);
+	vel += acc * t_ctrl;
+}
\ No newline at end of file
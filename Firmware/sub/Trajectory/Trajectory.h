@@ -0,0 +1,17 @@
+/**
+ * @file Trajectory.h
+ * @brief Subsystem for on-robot command trajectory generation
+ * @author agent
+ */
+#pragma once
+
+/**
+ * Namespace Declaration
+ */
+namespace Trajectory
+{
+	void init();
+	void update();
+	float get_lin_vel_cmd();
+	float get_yaw_vel_cmd();
+}
\ No newline at end of file
@@ -0,0 +1,544 @@
+/**
+ * @file main.cpp
+ * @brief Explicit constrained balance controller table generator
+ * @author agent
+ *
+ * Solves a voltage-constrained MPC offline at every point of a grid and
+ * prints the CtrlTable.cpp table code for both torque ratios. This is the
+ * generator of the committed tables, and solves the same problem as
+ * Matlab/balbot_empc.m (which needs the Optimization Toolbox).
+ *
+ * The balance model is the one in Controller.cpp:
+ *
+ *     Mx * pitch'' = Tg * pitch + tau
+ *     My * vel' = tau
+ *     tau = Gt * (V - Gv * vel)
+ *
+ * with state x = [pitch; pitch_vel; vel_err] at zero velocity command and
+ * input u = V, limited to |u| <= Vb. The MPC cost is the sum of squared
+ * deviations from the ss_K* pole placement law u_lin = -K * x over the
+ * horizon, so the MPC matches the linear law wherever no limit is hit.
+ *
+ * The MPC and the clamped linear law only differ in a thin band of states
+ * where u_lin is inside the limits. The band is narrow along vel_err (the
+ * law's largest gain), so the grid is over (pitch, pitch_vel, u_lin)
+ * instead, which spans it with points along u_lin. The correction vanishes
+ * just past |u_lin| = Vb, where both saturate, so the u_lin range ends 1 V
+ * past Vb with zero border entries. The correction is odd in the state, so
+ * only pitch >= 0 is stored.
+ *
+ * Usage: program [options]
+ *   -N, --horizon N  MPC horizon [50 control periods]
+ *   -c, --check      Print interpolation error at grid cell centres instead
+ */
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+// Physical Constants [see Controller.cpp and MotorConfig.cpp]
+const double t_ctrl = 0.01;		// Control period [s]
+const double Vb = 12.0;			// Nominal battery voltage [V]
+const double i_NL = 0.12;		// No-load current [A]
+const double R = 5.4;			// Resistance [Ohm]
+const double Ix = 0.00215;		// Pitch inertia [kg*m^2]
+const double m = 0.955;			// Robot mass [kg]
+const double g = 9.81;			// Gravity [m/s^2]
+const double dg = 0.062;		// CG height [m]
+const double dr = 0.034;		// Wheel radius [m]
+const double px = 20.0;			// Pitch-velocity pole [1/s]
+
+// Grid [see CtrlTable.cpp]
+const int n_pitch = 5;				// Pitch points (from zero)
+const int n_pitch_vel = 11;			// Pitch velocity points
+const int n_u_lin = 27;				// Linear law points
+const double pitch_step = 0.2;		// Pitch step [rad]
+const double pitch_vel_min = -10.0;	// Min pitch velocity [rad/s]
+const double pitch_vel_step = 2.0;	// Pitch velocity step [rad/s]
+const double u_lin_min = -13.0;	// Min linear law [V]
+const double u_lin_step = 1.0;		// Linear law step [V]
+
+/**
+ * Dense row-major matrix
+ */
+typedef std::vector<double> Mat;
+
+/**
+ * Discrete balance model and MPC for one torque ratio
+ */
+struct Mpc
+{
+	int N;			// Horizon [control periods]
+	double A[3][3];	// State matrix
+	double B[3];	// Input matrix
+	double K[3];	// Pole placement gains
+	Mat H;			// QP Hessian [N x N]
+	Mat F;			// QP linear term per state [N x 3]
+};
+
+/**
+ * @brief Builds discrete model and MPC QP for given torque ratio
+ * @param tr Torque ratio
+ * @param N Horizon [control periods]
+ */
+Mpc make_mpc(double tr, int N)
+{
+	// Motor constants [see MotorConfig.cpp]
+	const double w_NL = 1047.0 / tr;
+	const double t_ST = 0.015 * tr;
+	const double Kv = (Vb - R * i_NL) / w_NL;
+	const double Kt = t_ST * R / Vb;
+
+	// Balance model constants [see Controller.cpp]
+	const double Mx = Ix * dr / dg;
+	const double My = m * dr;
+	const double Tg = m * g * dr;
+	const double Gt = 2.0 * Kt / R;
+	const double Gv = Kv / dr;
+
+	// Zero-order hold discretisation of [Ac, Bc; 0, 0] by scaling and squaring
+	const double M[4][4] =
+	{
+		{0.0, 1.0, 0.0, 0.0},
+		{Tg / Mx, 0.0, Gt * Gv / Mx, Gt / Mx},
+		{0.0, 0.0, -Gt * Gv / My, -Gt / My},
+		{0.0, 0.0, 0.0, 0.0}
+	};
+	const int squarings = 8;
+	double E[4][4], T[4][4];
+	for (int i = 0; i < 4; i++)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			E[i][j] = T[i][j] = (i == j);
+		}
+	}
+	for (int k = 1; k < 20; k++)
+	{
+		double P[4][4] = {};
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				for (int l = 0; l < 4; l++)
+					P[i][j] += T[i][l] * M[l][j] * t_ctrl / (1 << squarings) / k;
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				E[i][j] += (T[i][j] = P[i][j]);
+	}
+	for (int q = 0; q < squarings; q++)
+	{
+		double P[4][4] = {};
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				for (int l = 0; l < 4; l++)
+					P[i][j] += E[i][l] * E[l][j];
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				E[i][j] = P[i][j];
+	}
+	Mpc mpc;
+	mpc.N = N;
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++) mpc.A[i][j] = E[i][j];
+		mpc.B[i] = E[i][3];
+	}
+
+	// Pole placement law u = -K * x [see Controller.cpp]
+	mpc.K[0] = 3.0*Mx/Gt*px*px + Tg/Gt;
+	mpc.K[1] = Mx*Mx/(Gt*Tg)*px*px*px + 3.0*Mx/Gt*px;
+	mpc.K[2] = Mx*My/(Gt*Tg)*px*px*px + Gv;
+
+	// Law deviations over horizon: d = G * U + D * x0
+	Mat G(N * N), D(N * 3);
+	double Phi[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+	Mat Gam(3 * N, 0.0);
+	for (int k = 0; k < N; k++)
+	{
+		for (int c = 0; c < N; c++)
+		{
+			G[k * N + c] = (c == k);
+			for (int i = 0; i < 3; i++) G[k * N + c] += mpc.K[i] * Gam[i * N + c];
+		}
+		for (int j = 0; j < 3; j++)
+		{
+			D[k * 3 + j] = 0.0;
+			for (int i = 0; i < 3; i++) D[k * 3 + j] += mpc.K[i] * Phi[i][j];
+		}
+		Mat Gam_next(3 * N);
+		double Phi_next[3][3];
+		for (int i = 0; i < 3; i++)
+		{
+			for (int c = 0; c < N; c++)
+			{
+				Gam_next[i * N + c] = (c == k) * mpc.B[i];
+				for (int l = 0; l < 3; l++) Gam_next[i * N + c] += mpc.A[i][l] * Gam[l * N + c];
+			}
+			for (int j = 0; j < 3; j++)
+			{
+				Phi_next[i][j] = 0.0;
+				for (int l = 0; l < 3; l++) Phi_next[i][j] += mpc.A[i][l] * Phi[l][j];
+			}
+		}
+		Gam = Gam_next;
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				Phi[i][j] = Phi_next[i][j];
+	}
+
+	// Cost 1/2 U' * H * U + (F * x0)' * U
+	mpc.H.assign(N * N, 0.0);
+	mpc.F.assign(N * 3, 0.0);
+	for (int a = 0; a < N; a++)
+	{
+		for (int k = 0; k < N; k++)
+		{
+			for (int b = 0; b < N; b++) mpc.H[a * N + b] += G[k * N + a] * G[k * N + b];
+			for (int j = 0; j < 3; j++) mpc.F[a * 3 + j] += G[k * N + a] * D[k * 3 + j];
+		}
+	}
+	return mpc;
+}
+
+/**
+ * @brief Solves M * x = b in place by Gaussian elimination with pivoting
+ * @param M Matrix [n x n] (destroyed)
+ * @param b Right-hand side [n] (solution on return)
+ */
+void solve(Mat& M, std::vector<double>& b)
+{
+	const int n = b.size();
+	for (int c = 0; c < n; c++)
+	{
+		int p = c;
+		for (int r = c + 1; r < n; r++)
+		{
+			if (fabs(M[r * n + c]) > fabs(M[p * n + c])) p = r;
+		}
+		for (int k = 0; k < n; k++) std::swap(M[c * n + k], M[p * n + k]);
+		std::swap(b[c], b[p]);
+		for (int r = c + 1; r < n; r++)
+		{
+			const double f = M[r * n + c] / M[c * n + c];
+			for (int k = c; k < n; k++) M[r * n + k] -= f * M[c * n + k];
+			b[r] -= f * b[c];
+		}
+	}
+	for (int r = n - 1; r >= 0; r--)
+	{
+		for (int k = r + 1; k < n; k++) b[r] -= M[r * n + k] * b[k];
+		b[r] /= M[r * n + r];
+	}
+}
+
+/**
+ * @brief Returns first MPC move from state x0 [V]
+ *
+ * Primal active-set solver for the box-constrained QP |U| <= Vb.
+ */
+double solve_mpc(const Mpc& mpc, const double x0[3])
+{
+	const int N = mpc.N;
+	std::vector<double> f(N), U(N, 0.0);
+	std::vector<int> W(N, 0);	// Bound: 0 free, +1 upper, -1 lower
+	for (int a = 0; a < N; a++)
+	{
+		f[a] = 0.0;
+		for (int j = 0; j < 3; j++) f[a] += mpc.F[a * 3 + j] * x0[j];
+	}
+	for (int iter = 0; iter < 10 * N; iter++)
+	{
+		// Minimise over free moves with bound moves fixed
+		std::vector<int> free;
+		for (int a = 0; a < N; a++) if (!W[a]) free.push_back(a);
+		const int n = free.size();
+		std::vector<double> step(U);
+		if (n)
+		{
+			Mat M(n * n);
+			std::vector<double> b(n);
+			for (int i = 0; i < n; i++)
+			{
+				b[i] = -f[free[i]];
+				for (int a = 0; a < N; a++)
+				{
+					if (W[a]) b[i] -= mpc.H[free[i] * N + a] * U[a];
+				}
+				for (int j = 0; j < n; j++) M[i * n + j] = mpc.H[free[i] * N + free[j]];
+			}
+			solve(M, b);
+			for (int i = 0; i < n; i++) step[free[i]] = b[i];
+		}
+
+		// Step towards minimum until first bound is hit
+		double alpha = 1.0;
+		int block = -1;
+		for (int a : free)
+		{
+			const double p = step[a] - U[a];
+			const double lim = (p > 0.0) ? Vb : -Vb;
+			if (fabs(p) > 1e-12 && fabs(U[a] + p) > Vb)
+			{
+				const double al = (lim - U[a]) / p;
+				if (al < alpha)
+				{
+					alpha = al;
+					block = a;
+				}
+			}
+		}
+		for (int a : free) U[a] += alpha * (step[a] - U[a]);
+		if (block >= 0)
+		{
+			W[block] = (U[block] > 0.0) ? 1 : -1;
+			U[block] = W[block] * Vb;
+			continue;
+		}
+
+		// Release bound with most negative multiplier, or finish
+		int release = -1;
+		double worst = 1e-9;
+		for (int a = 0; a < N; a++)
+		{
+			if (!W[a]) continue;
+			double grad = f[a];
+			for (int b = 0; b < N; b++) grad += mpc.H[a * N + b] * U[b];
+			const double viol = W[a] * grad;
+			if (viol > worst)
+			{
+				worst = viol;
+				release = a;
+			}
+		}
+		if (release < 0) break;
+		W[release] = 0;
+	}
+	return U[0];
+}
+
+/**
+ * @brief Returns MPC correction to clamped linear law [V]
+ * @param pitch Pitch angle [rad]
+ * @param pitch_vel Pitch velocity [rad/s]
+ * @param u_lin Linear law -K * x [V]
+ */
+double correction(const Mpc& mpc, double pitch, double pitch_vel, double u_lin)
+{
+	const double vel_err = -(u_lin + mpc.K[0] * pitch + mpc.K[1] * pitch_vel) / mpc.K[2];
+	const double x0[3] = {pitch, pitch_vel, vel_err};
+	return solve_mpc(mpc, x0) - fmax(-Vb, fmin(Vb, u_lin));
+}
+
+/**
+ * Correction table [mV], index (i_pitch * n_pitch_vel + i_pitch_vel) *
+ * n_u_lin + i_u_lin
+ */
+typedef std::vector<long> Table;
+
+/**
+ * @brief Returns table index of grid point
+ */
+int index(int i, int j, int k)
+{
+	return (i * n_pitch_vel + j) * n_u_lin + k;
+}
+
+/**
+ * @brief Solves correction table
+ *
+ * The pitch = 0 plane is made exactly odd so lookups are continuous where
+ * CtrlTable mirrors negative pitch.
+ */
+Table make_table(const Mpc& mpc)
+{
+	Table table(n_pitch * n_pitch_vel * n_u_lin);
+	for (int i = 0; i < n_pitch; i++)
+	{
+		for (int j = 0; j < n_pitch_vel; j++)
+		{
+			for (int k = 0; k < n_u_lin; k++)
+			{
+				const double u = correction(mpc,
+					i * pitch_step,
+					pitch_vel_min + j * pitch_vel_step,
+					u_lin_min + k * u_lin_step);
+				table[index(i, j, k)] = lround(1000.0 * u);
+			}
+		}
+	}
+	for (int j = 0; j < n_pitch_vel; j++)
+	{
+		for (int k = 0; k < n_u_lin; k++)
+		{
+			const int jk = index(0, j, k);
+			const int jk_neg = index(0, n_pitch_vel - 1 - j, n_u_lin - 1 - k);
+			if (jk < jk_neg)
+			{
+				const long v = (table[jk] - table[jk_neg]) / 2;
+				table[jk] = v;
+				table[jk_neg] = -v;
+			}
+			else if (jk == jk_neg)
+			{
+				table[jk] = 0;
+			}
+		}
+	}
+	return table;
+}
+
+/**
+ * @brief Returns true if table is zero at both ends of the u_lin range
+ *
+ * CtrlTable returns zero outside the u_lin range, which is only continuous
+ * if the border entries are zero.
+ */
+bool check_border(const Table& table)
+{
+	for (int i = 0; i < n_pitch; i++)
+	{
+		for (int j = 0; j < n_pitch_vel; j++)
+		{
+			if (table[index(i, j, 0)] || table[index(i, j, n_u_lin - 1)]) return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Returns interpolated table correction [V]
+ *
+ * Matches CtrlTable::lookup: negative pitch is mirrored, pitch and
+ * pitch_vel are clamped to the grid, and the correction is zero outside the
+ * u_lin range.
+ */
+double lookup(const Table& table, double pitch, double pitch_vel, double u_lin)
+{
+	if (pitch < 0.0) return -lookup(table, -pitch, -pitch_vel, -u_lin);
+	const double z = (u_lin - u_lin_min) / u_lin_step;
+	if (!(z >= 0.0 && z <= n_u_lin - 1)) return 0.0;
+	const double x = fmin(pitch / pitch_step, n_pitch - 1);
+	const double y = fmin(fmax((pitch_vel - pitch_vel_min) / pitch_vel_step, 0.0), n_pitch_vel - 1);
+	const int i = (int)fmin(x, n_pitch - 2);
+	const int j = (int)fmin(y, n_pitch_vel - 2);
+	const int k = (int)fmin(z, n_u_lin - 2);
+	double v = 0.0;
+	for (int a = 0; a < 2; a++)
+	{
+		for (int b = 0; b < 2; b++)
+		{
+			for (int c = 0; c < 2; c++)
+			{
+				const double w =
+					(a ? x - i : 1.0 - (x - i)) *
+					(b ? y - j : 1.0 - (y - j)) *
+					(c ? z - k : 1.0 - (z - k));
+				v += w * table[index(i + a, j + b, k + c)];
+			}
+		}
+	}
+	return 0.001 * v;
+}
+
+/**
+ * @brief Prints interpolation error at the centres of the grid cells
+ */
+void check(const Mpc& mpc, const Table& table)
+{
+	double max_err = 0.0, sum_sq = 0.0, max_corr = 0.0;
+	int n = 0;
+	for (int i = 0; i < n_pitch - 1; i++)
+	{
+		for (int j = 0; j < n_pitch_vel - 1; j++)
+		{
+			for (int k = 0; k < n_u_lin - 1; k++)
+			{
+				const double pitch = (i + 0.5) * pitch_step;
+				const double pitch_vel = pitch_vel_min + (j + 0.5) * pitch_vel_step;
+				const double u_lin = u_lin_min + (k + 0.5) * u_lin_step;
+				const double u = correction(mpc, pitch, pitch_vel, u_lin);
+				const double err = lookup(table, pitch, pitch_vel, u_lin) - u;
+				max_err = fmax(max_err, fabs(err));
+				max_corr = fmax(max_corr, fabs(u));
+				sum_sq += err * err;
+				n++;
+			}
+		}
+	}
+	printf("Cell-centre correction max %.3f V, interpolation error max %.3f V, rms %.3f V\n",
+		max_corr, max_err, sqrt(sum_sq / n));
+}
+
+/**
+ * @brief Prints CtrlTable code for table (one row per pitch and pitch_vel)
+ */
+void print_table(const Table& table)
+{
+	int nonzero = 0;
+	for (long v : table) nonzero += (v != 0);
+	if (nonzero == 0)
+	{
+		printf("\tconst bool has_table = false;\t// Linear law optimal on whole grid\n");
+		printf("\tconst int16_t table[1] PROGMEM = {0};\n");
+		return;
+	}
+	printf("\tconst bool has_table = true;\n");
+	printf("\tconst int16_t table[] PROGMEM =\n\t{\n");
+	for (int ij = 0; ij < n_pitch * n_pitch_vel; ij++)
+	{
+		printf("\t\t");
+		for (int k = 0; k < n_u_lin; k++)
+		{
+			const bool last = (ij == n_pitch * n_pitch_vel - 1) && (k == n_u_lin - 1);
+			printf("%ld%s", table[ij * n_u_lin + k], last ? "" : (k == n_u_lin - 1 ? "," : ", "));
+		}
+		printf("\n");
+	}
+	printf("\t};\n");
+}
+
+/**
+ * @brief Generates tables for both torque ratios
+ */
+int main(int argc, char** argv)
+{
+	// Parse options
+	int N = 50;
+	bool check_only = false;
+	const option long_opts[] =
+	{
+		{"horizon", required_argument, nullptr, 'N'},
+		{"check", no_argument, nullptr, 'c'},
+		{nullptr, 0, nullptr, 0}
+	};
+	int c;
+	while ((c = getopt_long(argc, argv, "N:c", long_opts, nullptr)) != -1)
+	{
+		switch (c)
+		{
+			case 'N': N = atoi(optarg); break;
+			case 'c': check_only = true; break;
+			default:
+				fprintf(stderr, "See main.cpp header for usage.\n");
+				return 1;
+		}
+	}
+
+	// Generate table for each torque ratio
+	printf("Balancing Robot Explicit MPC Generator (N = %d)\n", N);
+	const double trs[] = {30.0, 56.0};
+	for (double tr : trs)
+	{
+		const Mpc mpc = make_mpc(tr, N);
+		const Table table = make_table(mpc);
+		printf("\nCtrlTable Code (tr = %.0f):\n", tr);
+		if (!check_border(table))
+		{
+			fprintf(stderr, "Correction non-zero at u_lin range ends, extend range.\n");
+			return 1;
+		}
+		if (check_only) check(mpc, table);
+		else print_table(table);
+	}
+	return 0;
+}
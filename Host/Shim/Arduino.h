@@ -0,0 +1,82 @@
+/**
+ * @file Arduino.h
+ * @brief Native stand-in for the Arduino core used by firmware subsystems
+ * @author agent
+ * 
+ * Pin and interrupt calls do nothing and time comes from the host clock.
+ * HardwareSerial is only declared, so each host program defines where
+ * Serial bytes go.
+ */
+#pragma once
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include <time.h>
+
+// Pin Constants
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define SDA 18
+#define SCL 19
+
+// Pins and Interrupts
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return HIGH; }
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+inline void attachInterrupt(int, void (*)(), int) {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+// Time
+inline unsigned long micros()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000UL + ts.tv_nsec / 1000UL;
+}
+inline unsigned long millis() { return micros() / 1000UL; }
+inline void delayMicroseconds(unsigned int) {}
+inline void delay(unsigned long) {}
+
+// Flash Strings
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+/**
+ * @brief Serial port (defined by each host program)
+ */
+class HardwareSerial
+{
+public:
+	void begin(unsigned long baud);
+	int available();
+	int read();
+	size_t write(uint8_t byte);
+	void flush();
+	size_t print(const char* str);
+	size_t print(const __FlashStringHelper* str);
+	size_t print(double val, int digits = 2);
+	size_t print(int val);
+	size_t print(unsigned int val);
+	size_t print(long val);
+	size_t print(unsigned long val);
+	size_t println();
+	template<typename T> size_t println(T val)
+	{
+		return print(val) + println();
+	}
+	size_t println(double val, int digits)
+	{
+		return print(val, digits) + println();
+	}
+};
+extern HardwareSerial Serial;
\ No newline at end of file
@@ -0,0 +1,17 @@
+/**
+ * @file DigitalIn.h
+ * @brief Native stand-in for the DigitalIn library
+ * @author agent
+ */
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @brief Digital input pin (reads low)
+ */
+class DigitalIn
+{
+public:
+	DigitalIn(uint8_t) {}
+	operator bool() { return false; }
+};
\ No newline at end of file
@@ -0,0 +1,17 @@
+/**
+ * @file DigitalOut.h
+ * @brief Native stand-in for the DigitalOut library
+ * @author agent
+ */
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @brief Digital output pin (writes are dropped)
+ */
+class DigitalOut
+{
+public:
+	DigitalOut(uint8_t) {}
+	DigitalOut& operator=(bool) { return *this; }
+};
\ No newline at end of file
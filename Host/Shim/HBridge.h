@@ -0,0 +1,18 @@
+/**
+ * @file HBridge.h
+ * @brief Native stand-in for the HBridge library
+ * @author agent
+ */
+#pragma once
+#include <PwmOut.h>
+#include <DigitalOut.h>
+
+/**
+ * @brief H-bridge motor driver (voltage commands are dropped)
+ */
+class HBridge
+{
+public:
+	HBridge(PwmOut*, DigitalOut*, DigitalOut*, float) {}
+	void set_voltage(float) {}
+};
\ No newline at end of file
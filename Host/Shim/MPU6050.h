@@ -0,0 +1,34 @@
+/**
+ * @file MPU6050.h
+ * @brief Native stand-in for the MPU6050 library (no device attached)
+ * @author agent
+ */
+#pragma once
+#include <Wire.h>
+
+/**
+ * @brief MPU6050 that never initializes and reads zeros
+ */
+class MPU6050
+{
+public:
+	MPU6050(TwoWire*) {}
+	bool init() { return false; }
+	void update() {}
+	void calibrate() {}
+	float get_acc_x() { return 0.0f; }
+	float get_acc_y() { return 0.0f; }
+	float get_acc_z() { return 0.0f; }
+	float get_gyr_x() { return 0.0f; }
+	float get_gyr_y() { return 0.0f; }
+	float get_gyr_z() { return 0.0f; }
+	float get_acc_x_var() { return 0.0f; }
+	float get_acc_y_var() { return 0.0f; }
+	float get_acc_z_var() { return 0.0f; }
+	float get_gyr_x_var() { return 0.0f; }
+	float get_gyr_y_var() { return 0.0f; }
+	float get_gyr_z_var() { return 0.0f; }
+	float gyr_x_cal = 0.0f;
+	float gyr_y_cal = 0.0f;
+	float gyr_z_cal = 0.0f;
+};
\ No newline at end of file
@@ -0,0 +1,10 @@
+/**
+ * @file PinChangeInt.h
+ * @brief Native stand-in for the PinChangeInt library
+ * @author agent
+ */
+#pragma once
+#include <Arduino.h>
+
+// Pin change interrupts never fire on the host
+inline void attachPinChangeInterrupt(uint8_t, void (*)(), int) {}
\ No newline at end of file
@@ -0,0 +1,17 @@
+/**
+ * @file PwmOut.h
+ * @brief Native stand-in for the PwmOut library
+ * @author agent
+ */
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @brief PWM output pin (writes are dropped)
+ */
+class PwmOut
+{
+public:
+	PwmOut(uint8_t) {}
+	PwmOut& operator=(float) { return *this; }
+};
\ No newline at end of file
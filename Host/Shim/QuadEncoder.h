@@ -0,0 +1,19 @@
+/**
+ * @file QuadEncoder.h
+ * @brief Native stand-in for the QuadEncoder library
+ * @author agent
+ */
+#pragma once
+#include <DigitalIn.h>
+
+/**
+ * @brief Quadrature encoder that never moves
+ */
+class QuadEncoder
+{
+public:
+	QuadEncoder(DigitalIn*, DigitalIn*, float) {}
+	void interrupt_A() {}
+	void interrupt_B() {}
+	float get_angle() { return 0.0f; }
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+/**
+ * @file SerialStruct.h
+ * @brief Native stand-in for the SerialStruct library
+ * @author agent
+ * 
+ * Sends and receives values as raw little-endian bytes over a
+ * HardwareSerial, matching the firmware wire format on the host.
+ */
+#pragma once
+#include <Arduino.h>
+#include <string.h>
+
+/**
+ * @brief Binary value transfer over serial
+ */
+class SerialStruct
+{
+public:
+	SerialStruct(HardwareSerial* serial) : serial(serial) {}
+
+	/**
+	 * @brief Discards all received bytes
+	 */
+	void flush()
+	{
+		while (serial->available() > 0) serial->read();
+	}
+
+	/**
+	 * @brief Reads value from serial (bytes must be available)
+	 */
+	template<typename T> void rx(T& x)
+	{
+		uint8_t buf[sizeof(T)];
+		for (size_t i = 0; i < sizeof(T); i++) buf[i] = serial->read();
+		memcpy(&x, buf, sizeof(T));
+	}
+
+	/**
+	 * @brief Writes value to serial
+	 */
+	template<typename T> void tx(T x)
+	{
+		uint8_t buf[sizeof(T)];
+		memcpy(buf, &x, sizeof(T));
+		for (size_t i = 0; i < sizeof(T); i++) serial->write(buf[i]);
+	}
+
+private:
+	HardwareSerial* serial;
+};
\ No newline at end of file
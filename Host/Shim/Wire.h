@@ -0,0 +1,27 @@
+/**
+ * @file Wire.h
+ * @brief Native stand-in for the Arduino I2C library (no devices attached)
+ * @author agent
+ */
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @brief I2C bus with no devices (all transfers fail)
+ */
+class TwoWire
+{
+public:
+	void begin() {}
+	void end() {}
+	void setClock(uint32_t) {}
+	void setWireTimeout(uint32_t, bool) {}
+	bool getWireTimeoutFlag() { return false; }
+	void clearWireTimeoutFlag() {}
+	void beginTransmission(uint8_t) {}
+	uint8_t endTransmission(bool = true) { return 2; }
+	uint8_t requestFrom(uint8_t, uint8_t) { return 0; }
+	size_t write(uint8_t) { return 0; }
+	int read() { return -1; }
+};
+static TwoWire Wire;
\ No newline at end of file
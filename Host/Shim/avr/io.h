@@ -0,0 +1,34 @@
+/**
+ * @file io.h
+ * @brief Native stand-in for the ATmega328P ADC registers
+ * @author agent
+ * 
+ * Register writes land in plain variables and ISRs are never called, so
+ * subsystems that configure the ADC compile and run without effect.
+ */
+#pragma once
+#include <stdint.h>
+
+// ADC Registers
+static volatile uint8_t ADMUX, ADCSRA, ADCSRB, DIDR0;
+static volatile uint16_t ADC;
+
+// ADC Register Bits
+#define REFS0 6
+#define ADEN 7
+#define ADSC 6
+#define ADATE 5
+#define ADIF 4
+#define ADIE 3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+#define ADTS2 2
+#define ADTS1 1
+#define ADTS0 0
+#define ADC0D 0
+#define _BV(bit) (1 << (bit))
+
+// Interrupt Vectors
+#define ISR(vector) extern "C" void vector(void)
+#define ADC_vect __vector_adc
\ No newline at end of file
@@ -0,0 +1,11 @@
+/**
+ * @file pgmspace.h
+ * @brief Native stand-in for AVR program memory access
+ * @author agent
+ */
+#pragma once
+#include <stdint.h>
+
+// Flash tables live in ordinary memory on the host
+#define PROGMEM
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
\ No newline at end of file
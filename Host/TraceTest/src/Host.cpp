@@ -0,0 +1,37 @@
+/**
+ * @file Host.cpp
+ * @brief Host definitions for firmware dependencies outside the trace
+ * @author agent
+ * 
+ * The trace drives the controller with explicit commands, so Trajectory
+ * never runs. Serial output (Imu::calibrate) goes to stdout.
+ */
+#include <Arduino.h>
+#include <Trajectory.h>
+#include <stdio.h>
+
+/**
+ * Trajectory (commands come from the trace)
+ */
+void Trajectory::init() {}
+void Trajectory::update() {}
+float Trajectory::get_lin_vel_cmd() { return 0.0f; }
+float Trajectory::get_yaw_vel_cmd() { return 0.0f; }
+
+/**
+ * Serial (output to stdout, no input)
+ */
+HardwareSerial Serial;
+void HardwareSerial::begin(unsigned long) {}
+int HardwareSerial::available() { return 0; }
+int HardwareSerial::read() { return -1; }
+size_t HardwareSerial::write(uint8_t byte) { return fwrite(&byte, 1, 1, stdout); }
+void HardwareSerial::flush() { fflush(stdout); }
+size_t HardwareSerial::print(const char* str) { return printf("%s", str); }
+size_t HardwareSerial::print(const __FlashStringHelper* str) { return print((const char*)str); }
+size_t HardwareSerial::print(double val, int digits) { return printf("%.*f", digits, val); }
+size_t HardwareSerial::print(int val) { return printf("%d", val); }
+size_t HardwareSerial::print(unsigned int val) { return printf("%u", val); }
+size_t HardwareSerial::print(long val) { return printf("%ld", val); }
+size_t HardwareSerial::print(unsigned long val) { return printf("%lu", val); }
+size_t HardwareSerial::println() { return printf("\r\n"); }
\ No newline at end of file
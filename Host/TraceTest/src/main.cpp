@@ -0,0 +1,482 @@
+/**
+ * @file main.cpp
+ * @brief Native golden-trace test of the firmware estimator and controller
+ * @author agent
+ * 
+ * Replays input traces through the firmware Imu, MotorL/R and Controller
+ * process functions (with the real GRV, LTIFilter and PID libraries) and
+ * compares the outputs to the golden files in golden/botNN/. Exits
+ * non-zero if any output leaves its tolerance. The on-robot replay in
+ * Matlab/balbot_trace.m uses the same files. Also checks that the
+ * CtrlTable lookup has no steps across its grid edges.
+ * 
+ * Golden outputs depend on the robot's motor and IMU configs, so each
+ * robot ID has its own set, selected by ES3011_BOT_ID at build time. A set
+ * holds the built-in traces below plus any recorded traces (other *.csv
+ * files in the directory, e.g. from VirtualBot --record).
+ * 
+ * Trace inputs (13 columns, see Diagnostics::run_trace):
+ *   acc_y, acc_z, gyr_x, gyr_x_new, gyr_y, gyr_z, t_int, n,
+ *   angle_L, angle_R, lin_vel_cmd, yaw_vel_cmd, v_bat
+ * 
+ * Trace outputs (7 columns):
+ *   pitch, pitch_vel, yaw_vel, vel_L, vel_R, volts_L, volts_R
+ * 
+ * Usage: program [options]
+ *   -d, --dir DIR    Golden file directory [golden/botNN]
+ *   -u, --update     Rewrite golden outputs (inputs of existing files are
+ *                    kept, missing built-in traces are generated)
+ *   -a, --add FILE   Add recorded input file (13-column CSV with header)
+ *                    as a golden trace of the same name
+ */
+#include <Imu.h>
+#include <MotorL.h>
+#include <MotorR.h>
+#include <Battery.h>
+#include <Controller.h>
+#include <CtrlTable.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+using Controller::t_ctrl;
+
+// Trace Format
+const int n_in = 13;
+const int n_out = 7;
+const char* const in_names[n_in] =
+{
+	"acc_y", "acc_z", "gyr_x", "gyr_x_new", "gyr_y", "gyr_z", "t_int", "n",
+	"angle_L", "angle_R", "lin_vel_cmd", "yaw_vel_cmd", "v_bat"
+};
+const char* const out_names[n_out] =
+{
+	"pitch", "pitch_vel", "yaw_vel", "vel_L", "vel_R", "volts_L", "volts_R"
+};
+const float out_tols[n_out] = {1e-4f, 1e-4f, 1e-4f, 1e-3f, 1e-3f, 1e-3f, 1e-3f};
+
+// CtrlTable Edge Check
+// Edges are the grid faces, the mirrored pitch = 0 plane and points beyond,
+// with the other coordinates swept over ranges covering the grid
+const float edges[3][4] =
+{
+	{0.0f, 0.8f, -0.8f, 1.0f},		// Pitch [rad]
+	{-10.0f, 10.0f, 0.0f, 5.0f},	// Pitch velocity [rad/s]
+	{-13.0f, 13.0f, -12.0f, 12.0f}	// Linear law [V]
+};
+const float sweep_max[3] = {1.0f, 12.0f, 14.0f};	// Sweep range [+-]
+const int sweep_n = 81;								// Sweep points
+const float edge_eps = 1e-4f;						// Edge offset
+const float edge_tol = 1e-2f;						// Max step [V]
+
+// Built-in Traces
+const char* const trace_names[] = {"step", "ramp", "noise", "fifo"};
+const int n_traces = sizeof(trace_names) / sizeof(trace_names[0]);
+const int n_samples = 200;
+
+/**
+ * Input or output samples
+ */
+typedef std::vector<std::vector<float>> Samples;
+
+/**
+ * @brief Returns standard normal sample from fixed-seed generator
+ * 
+ * Uses its own xorshift generator and Box-Muller transform so generated
+ * traces do not depend on the C++ library's distributions.
+ */
+float randn()
+{
+	static uint32_t state = 2463534242u;
+	float u[2];
+	for (int i = 0; i < 2; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		u[i] = (state + 1.0f) / 4294967296.0f;
+	}
+	return sqrtf(-2.0f * logf(u[0])) * cosf(2.0f * (float)M_PI * u[1]);
+}
+
+/**
+ * @brief Generates built-in input trace
+ * @param name Trace name
+ * 
+ * step, ramp and noise use the single-reading path (n = 1, t_int =
+ * t_ctrl). fifo uses the FIFO path (n = 9-11 samples at 1 kHz) with
+ * gyr_x_new leading the period mean.
+ */
+Samples make_trace(const std::string& name)
+{
+	const float g = 9.81f;
+	const std::vector<float> rest = {0, g, 0, 0, 0, 0, t_ctrl, 1, 0, 0, 0, 0, 12.0f};
+	Samples in(n_samples, rest);
+	float enc_L = 0.0f, enc_R = 0.0f;
+	for (int k = 0; k < n_samples; k++)
+	{
+		std::vector<float>& x = in[k];
+		const float r = (float)k / n_samples;
+		if (name == "step" && k >= n_samples / 4)
+		{
+			x[0] = g * sinf(0.1f);
+			x[1] = g * cosf(0.1f);
+			x[2] = x[3] = 0.5f;
+			x[5] = 0.3f;
+			x[8] = 1.0f;
+			x[9] = 1.2f;
+			x[10] = 0.5f;
+			x[11] = 1.0f;
+			x[12] = 11.0f;
+		}
+		else if (name == "ramp")
+		{
+			const float pitch = 0.3f * r;
+			x[0] = g * sinf(pitch);
+			x[1] = g * cosf(pitch);
+			x[2] = x[3] = 0.3f / (n_samples * t_ctrl);
+			x[8] = 10.0f * t_ctrl * k;
+			x[9] = 8.0f * t_ctrl * k;
+			x[10] = 0.8f * r;
+			x[11] = -1.6f * r;
+			x[12] = 12.6f - 2.6f * r;
+		}
+		else if (name == "noise")
+		{
+			x[0] += 0.3f * randn();
+			x[1] += 0.3f * randn();
+			x[2] = x[3] = 0.05f * randn();
+			x[4] += 0.05f * randn();
+			x[5] += 0.05f * randn();
+			x[8] = (enc_L += 0.02f * randn());
+			x[9] = (enc_R += 0.02f * randn());
+			x[10] += 0.5f * randn();
+			x[11] += 0.5f * randn();
+			x[12] += 0.2f * randn();
+		}
+		else if (name == "fifo")
+		{
+			const float w = 2.0f * (float)M_PI * 2.0f;
+			const float t_end = t_ctrl * (k + 1);
+			x[7] = 10 + k % 3 - 1;
+			x[6] = 1e-3f * x[7];
+			const float pitch = 0.1f * sinf(w * t_end);
+			x[0] = g * sinf(pitch);
+			x[1] = g * cosf(pitch);
+			x[2] = 0.1f * (sinf(w * t_end) - sinf(w * (t_end - x[6]))) / x[6];
+			x[3] = 0.1f * w * cosf(w * (t_end - 1e-3f));
+			x[5] = 0.5f;
+			x[8] = 2.0f * t_ctrl * k;
+			x[9] = 2.0f * t_ctrl * k;
+			x[10] = 0.2f;
+		}
+	}
+	return in;
+}
+
+/**
+ * @brief Runs input trace through firmware subsystems
+ * @param in Input samples
+ * @return Output samples
+ * 
+ * Matches Diagnostics::run_trace, including state resets.
+ */
+Samples run_trace(const Samples& in)
+{
+	Imu::reset();
+	MotorL::reset();
+	MotorR::reset();
+	Controller::reset();
+	Samples out;
+	for (const std::vector<float>& x : in)
+	{
+		Imu::process(x[0], x[1], x[2], x[3], x[4], x[5], x[6], (uint8_t)x[7]);
+		MotorL::process(x[8]);
+		MotorR::process(x[9]);
+		Controller::process(x[10], x[11], Battery::to_v_limit(x[12]));
+		out.push_back({
+			Imu::get_pitch(),
+			Imu::get_pitch_vel(),
+			Imu::get_yaw_vel(),
+			MotorL::get_velocity(),
+			MotorR::get_velocity(),
+			Controller::get_motor_L_cmd(),
+			Controller::get_motor_R_cmd()});
+	}
+	return out;
+}
+
+/**
+ * @brief Reads CSV file with header line
+ * @param path File path
+ * @param n_cols Number of columns
+ * @param rows Rows (output)
+ * @return True if file was read
+ */
+bool read_csv(const std::string& path, size_t n_cols, Samples& rows)
+{
+	FILE* file = fopen(path.c_str(), "r");
+	if (!file) return false;
+	char line[1024];
+	bool ok = fgets(line, sizeof(line), file) != nullptr;
+	rows.clear();
+	while (ok && fgets(line, sizeof(line), file))
+	{
+		std::vector<float> row;
+		for (char* tok = strtok(line, ",\n"); tok; tok = strtok(nullptr, ",\n"))
+		{
+			row.push_back(strtof(tok, nullptr));
+		}
+		if (row.size() != n_cols)
+		{
+			ok = false;
+			break;
+		}
+		rows.push_back(row);
+	}
+	fclose(file);
+	return ok && !rows.empty();
+}
+
+/**
+ * @brief Reads golden file
+ * @param path File path
+ * @param in Input samples (output)
+ * @param out Output samples (output)
+ * @return True if file was read
+ */
+bool read_golden(const std::string& path, Samples& in, Samples& out)
+{
+	Samples rows;
+	in.clear();
+	out.clear();
+	if (!read_csv(path, n_in + n_out, rows)) return false;
+	for (const std::vector<float>& row : rows)
+	{
+		in.emplace_back(row.begin(), row.begin() + n_in);
+		out.emplace_back(row.begin() + n_in, row.end());
+	}
+	return true;
+}
+
+/**
+ * @brief Returns trace names in golden directory
+ * @param dir Golden file directory
+ * 
+ * Built-in traces come first (even if missing), then recorded traces in
+ * name order.
+ */
+std::vector<std::string> list_traces(const std::string& dir)
+{
+	std::vector<std::string> names(trace_names, trace_names + n_traces);
+	std::vector<std::string> recorded;
+	DIR* d = opendir(dir.c_str());
+	if (d)
+	{
+		for (dirent* ent = readdir(d); ent; ent = readdir(d))
+		{
+			const std::string file = ent->d_name;
+			const size_t len = file.size();
+			if (len <= 4 || file.compare(len - 4, 4, ".csv") != 0) continue;
+			const std::string name = file.substr(0, len - 4);
+			if (std::find(names.begin(), names.end(), name) == names.end())
+			{
+				recorded.push_back(name);
+			}
+		}
+		closedir(d);
+	}
+	std::sort(recorded.begin(), recorded.end());
+	names.insert(names.end(), recorded.begin(), recorded.end());
+	return names;
+}
+
+/**
+ * @brief Writes golden file
+ * @param path File path
+ * @param in Input samples
+ * @param out Output samples
+ * @return True if file was written
+ */
+bool write_golden(const std::string& path, const Samples& in, const Samples& out)
+{
+	FILE* file = fopen(path.c_str(), "w");
+	if (!file) return false;
+	for (int j = 0; j < n_in + n_out; j++)
+	{
+		fprintf(file, "%s%s", j ? "," : "", j < n_in ? in_names[j] : out_names[j - n_in]);
+	}
+	fprintf(file, "\n");
+	for (size_t i = 0; i < in.size(); i++)
+	{
+		for (int j = 0; j < n_in + n_out; j++)
+		{
+			const float val = (j < n_in) ? in[i][j] : out[i][j - n_in];
+			fprintf(file, "%s%.9g", j ? "," : "", val);
+		}
+		fprintf(file, "\n");
+	}
+	return fclose(file) == 0;
+}
+
+/**
+ * @brief Compares outputs to golden outputs and prints results
+ * @param name Trace name
+ * @param out Output samples
+ * @param gold Golden output samples
+ * @return True if all outputs are within tolerance
+ */
+bool compare(const std::string& name, const Samples& out, const Samples& gold)
+{
+	printf("Trace '%s':\n", name.c_str());
+	bool pass = true;
+	for (int j = 0; j < n_out; j++)
+	{
+		float max_err = 0.0f;
+		for (size_t i = 0; i < out.size(); i++)
+		{
+			const float err = fabsf(out[i][j] - gold[i][j]);
+			if (!(err <= max_err)) max_err = isnan(err) ? INFINITY : err;
+		}
+		const bool ok = max_err <= out_tols[j];
+		pass = pass && ok;
+		printf("  %-10s max err %.3e (tol %.0e) %s\n",
+			out_names[j], max_err, out_tols[j], ok ? "pass" : "FAIL");
+	}
+	return pass;
+}
+
+/**
+ * @brief Checks CtrlTable lookup continuity across grid edges
+ * @return True if no step exceeds tolerance
+ */
+bool check_edges()
+{
+	float max_step = 0.0f;
+	for (int d = 0; d < 3; d++)
+	{
+		const int d1 = (d + 1) % 3;
+		const int d2 = (d + 2) % 3;
+		for (float edge : edges[d])
+		{
+			for (int a = 0; a < sweep_n; a++)
+			{
+				for (int b = 0; b < sweep_n; b++)
+				{
+					float x[3];
+					x[d1] = sweep_max[d1] * (2.0f * a / (sweep_n - 1) - 1.0f);
+					x[d2] = sweep_max[d2] * (2.0f * b / (sweep_n - 1) - 1.0f);
+					x[d] = edge - edge_eps;
+					const float lo = CtrlTable::lookup(x[0], x[1], x[2]);
+					x[d] = edge + edge_eps;
+					const float hi = CtrlTable::lookup(x[0], x[1], x[2]);
+					const float step = fabsf(hi - lo);
+					if (!(step <= max_step)) max_step = isnan(step) ? INFINITY : step;
+				}
+			}
+		}
+	}
+	const bool ok = max_step <= edge_tol;
+	printf("Table 'CtrlTable' edges:\n");
+	printf("  %-10s max step %.3e (tol %.0e) %s\n",
+		"lookup", max_step, edge_tol, ok ? "pass" : "FAIL");
+	return ok;
+}
+
+/**
+ * @brief Runs golden-trace test or updates golden files
+ */
+int main(int argc, char** argv)
+{
+	// Parse options
+	char dir_default[16];
+	snprintf(dir_default, sizeof(dir_default), "golden/bot%02d", ES3011_BOT_ID);
+	std::string dir = dir_default;
+	std::string add;
+	bool update = false;
+	const option long_opts[] =
+	{
+		{"dir", required_argument, nullptr, 'd'},
+		{"update", no_argument, nullptr, 'u'},
+		{"add", required_argument, nullptr, 'a'},
+		{nullptr, 0, nullptr, 0}
+	};
+	int c;
+	while ((c = getopt_long(argc, argv, "d:ua:", long_opts, nullptr)) != -1)
+	{
+		switch (c)
+		{
+			case 'd': dir = optarg; break;
+			case 'u': update = true; break;
+			case 'a': add = optarg; break;
+			default:
+				fprintf(stderr, "See main.cpp header for usage.\n");
+				return 1;
+		}
+	}
+
+	// Add recorded trace
+	if (!add.empty())
+	{
+		Samples in;
+		if (!read_csv(add, n_in, in))
+		{
+			fprintf(stderr, "Cannot read %d-column inputs from '%s'.\n", n_in, add.c_str());
+			return 1;
+		}
+		const size_t slash = add.find_last_of('/');
+		const std::string path = dir + "/" + add.substr(slash == std::string::npos ? 0 : slash + 1);
+		if (!write_golden(path, in, run_trace(in)))
+		{
+			fprintf(stderr, "Cannot write '%s'.\n", path.c_str());
+			return 1;
+		}
+		printf("Recorded trace written to '%s'.\n", path.c_str());
+		return 0;
+	}
+
+	// Run traces
+	printf("Balancing Robot Golden Trace Test (robot %d)\n\n", ES3011_BOT_ID);
+	bool all_pass = true;
+	for (const std::string& name : list_traces(dir))
+	{
+		const std::string path = dir + "/" + name + ".csv";
+		Samples in, gold;
+		const bool found = read_golden(path, in, gold);
+		const bool built_in = std::find(trace_names, trace_names + n_traces, name) != trace_names + n_traces;
+		if (update && (found || built_in))
+		{
+			if (!found) in = make_trace(name);
+			if (!write_golden(path, in, run_trace(in)))
+			{
+				fprintf(stderr, "Cannot write '%s'.\n", path.c_str());
+				return 1;
+			}
+			printf("Trace '%s': golden outputs written to '%s'.\n",
+				name.c_str(), path.c_str());
+		}
+		else if (!found)
+		{
+			printf("Trace '%s': cannot read '%s'.\n", name.c_str(), path.c_str());
+			all_pass = false;
+		}
+		else
+		{
+			all_pass = compare(name, run_trace(in), gold) && all_pass;
+		}
+	}
+
+	// Summary
+	if (update) return 0;
+	all_pass = check_edges() && all_pass;
+	printf(all_pass ?
+		"\nAll traces equivalent to golden traces.\n" :
+		"\nTraces NOT equivalent to golden traces.\n");
+	return all_pass ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+ * @file Link.cpp
+ * @author agent
+ */
+#include "Link.h"
+
+/**
+ * @brief Constructs link
+ * @param latency Fixed latency [s]
+ * @param jitter Max extra uniform random latency [s]
+ * @param loss Byte loss probability [0-1]
+ * @param baud Baud rate (10 bits per byte)
+ * @param seed Random seed
+ */
+Link::Link(float latency, float jitter, float loss, uint32_t baud, unsigned seed) :
+	rng(seed),
+	dist_jitter(0.0f, jitter),
+	dist_loss(0.0f, 1.0f),
+	latency(latency),
+	loss(loss),
+	t_byte(10.0 / baud),
+	t_last(0.0)
+{
+	return;
+}
+
+/**
+ * @brief Sends byte into link
+ * @param byte Data byte
+ * @param t Send time [s]
+ * 
+ * Bytes are dropped with probability loss. Delivery is never earlier than
+ * one byte time after the previous byte, so order is kept and throughput
+ * is limited to the baud rate.
+ */
+void Link::push(uint8_t byte, double t)
+{
+	if (dist_loss(rng) < loss) return;
+	double t_due = t + latency + dist_jitter(rng);
+	if (t_due < t_last + t_byte) t_due = t_last + t_byte;
+	t_last = t_due;
+	queue.push_back({t_due, byte});
+}
+
+/**
+ * @brief Receives byte from link if one is due
+ * @param byte Data byte (output)
+ * @param t Current time [s]
+ * @return True if a byte was received
+ */
+bool Link::pop(uint8_t& byte, double t)
+{
+	if (queue.empty() || queue.front().t_due > t) return false;
+	byte = queue.front().byte;
+	queue.pop_front();
+	return true;
+}
\ No newline at end of file
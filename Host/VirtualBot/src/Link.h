@@ -0,0 +1,34 @@
+/**
+ * @file Link.h
+ * @brief Simulated one-way serial radio link
+ * @author agent
+ */
+#pragma once
+#include <stdint.h>
+#include <deque>
+#include <random>
+
+/**
+ * Class Declaration
+ */
+class Link
+{
+public:
+	Link(float latency, float jitter, float loss, uint32_t baud, unsigned seed);
+	void push(uint8_t byte, double t);
+	bool pop(uint8_t& byte, double t);
+protected:
+	struct Pending
+	{
+		double t_due;	// Delivery time [s]
+		uint8_t byte;	// Data byte
+	};
+	std::deque<Pending> queue;
+	std::mt19937 rng;
+	std::uniform_real_distribution<float> dist_jitter;
+	std::uniform_real_distribution<float> dist_loss;
+	float latency;		// Fixed latency [s]
+	float loss;			// Byte loss probability
+	double t_byte;		// Byte time at baud rate [s]
+	double t_last;		// Last scheduled delivery [s]
+};
\ No newline at end of file
@@ -0,0 +1,187 @@
+/**
+ * @file Plant.cpp
+ * @author agent
+ */
+#include "Plant.h"
+#include <MotorConfig.h>
+#include <Controller.h>
+#include <math.h>
+#include <random>
+using MotorConfig::Kv;
+using MotorConfig::Kt;
+using MotorConfig::R;
+using Controller::dr;
+using Controller::dw;
+
+/**
+ * Namespace Definitions
+ * 
+ * The model is the Controller design model with sin(pitch) gravity, a
+ * fallen-over limit, and battery-limited voltages. Physical constants are
+ * kept separate from Controller.cpp so model mismatch can be tested.
+ */
+namespace Plant
+{
+	// Robot Physical Constants
+	const float Ix = 0.00215f;	// Pitch inertia [kg*m^2]
+	const float Iz = 0.00110f;	// Yaw inertia [kg*m^2]
+	const float m = 0.955f;		// Robot mass [kg]
+	const float g = 9.81f;		// Gravity [m/s^2]
+	const float dg = 0.062f;	// CG height [m]
+
+	// Derived Physical Constants
+	const float Mx = Ix*dr/dg;	// Generalized X-mass [kg*m^2]
+	const float My = m*dr;		// Generalized Y-mass [kg*m]
+	const float Mz = Iz*dr/dw;	// Generalized Z-mass [kg*m^2]
+	const float Tg = m*g*dr;	// Gravitational torque [N*m]
+	const float Gt = 2.0f*Kt/R;	// Torque-voltage gain [N*m/V]
+	const float Gv = Kv/dr;		// Linear back-EMF [V/(m/s)]
+	const float Gw = Kv*dw/dr;	// Yaw back-EMF [V/(rad/s)]
+
+	// Simulation Constants
+	const float t_step = 0.001f;	// Integration step [s]
+	const float pitch_fall = 1.4f;	// Fallen-over pitch [rad]
+
+	// State Variables
+	float pitch = 0.0f;		// Pitch [rad]
+	float pitch_vel = 0.0f;	// Pitch velocity [rad/s]
+	float dist = 0.0f;		// Distance travelled [m]
+	float lin_vel = 0.0f;	// Linear velocity [m/s]
+	float yaw = 0.0f;		// Yaw [rad]
+	float yaw_vel = 0.0f;	// Yaw velocity [rad/s]
+
+	// Inputs
+	float v_bat = 12.0f;	// Battery voltage [V]
+	float v_avg = 0.0f;		// Average motor voltage [V]
+	float v_diff = 0.0f;	// Differential motor voltage [V]
+
+	// Sensor Noise
+	std::mt19937 rng;
+}
+
+/**
+ * @brief Initializes plant state
+ * @param pitch_init Initial pitch [rad]
+ * @param v_bat_init Battery voltage [V]
+ * @param seed Noise seed
+ */
+void Plant::init(float pitch_init, float v_bat_init, unsigned seed)
+{
+	pitch = pitch_init;
+	v_bat = v_bat_init;
+	rng.seed(seed);
+}
+
+/**
+ * @brief Advances plant by given time [s]
+ */
+void Plant::step(float t)
+{
+	for (float t_sim = 0.0f; t_sim < t; t_sim += t_step)
+	{
+		// Motor torques
+		const float tau_avg = Gt * (v_avg - Gv * lin_vel);
+		const float tau_diff = Gt * (v_diff - Gw * yaw_vel);
+
+		// Euler integration
+		pitch_vel += t_step * (Tg * sinf(pitch) + tau_avg) / Mx;
+		pitch += t_step * pitch_vel;
+		lin_vel += t_step * tau_avg / My;
+		dist += t_step * lin_vel;
+		yaw_vel += t_step * tau_diff / Mz;
+		yaw += t_step * yaw_vel;
+
+		// Lie on ground when fallen over
+		if (fabsf(pitch) > pitch_fall)
+		{
+			pitch = copysignf(pitch_fall, pitch);
+			pitch_vel = 0.0f;
+			lin_vel = 0.0f;
+			yaw_vel = 0.0f;
+		}
+	}
+}
+
+/**
+ * @brief Sets motor voltages [V] (saturated at battery voltage)
+ */
+void Plant::set_voltages(float v_L, float v_R)
+{
+	v_L = fmaxf(-v_bat, fminf(v_bat, v_L));
+	v_R = fmaxf(-v_bat, fminf(v_bat, v_R));
+	v_avg = 0.5f * (v_L + v_R);
+	v_diff = 0.5f * (v_R - v_L);
+}
+
+/**
+ * @brief Returns battery voltage [V]
+ */
+float Plant::get_v_bat()
+{
+	return v_bat;
+}
+
+/**
+ * @brief Returns pitch [rad]
+ */
+float Plant::get_pitch()
+{
+	return pitch;
+}
+
+/**
+ * @brief Returns pitch velocity [rad/s]
+ */
+float Plant::get_pitch_vel()
+{
+	return pitch_vel;
+}
+
+/**
+ * @brief Returns yaw velocity [rad/s]
+ */
+float Plant::get_yaw_vel()
+{
+	return yaw_vel;
+}
+
+/**
+ * @brief Returns left wheel ground angle [rad]
+ */
+float Plant::get_angle_L()
+{
+	return (dist - dw * yaw) / dr;
+}
+
+/**
+ * @brief Returns right wheel ground angle [rad]
+ */
+float Plant::get_angle_R()
+{
+	return (dist + dw * yaw) / dr;
+}
+
+/**
+ * @brief Returns left wheel ground velocity [rad/s]
+ */
+float Plant::get_velocity_L()
+{
+	return (lin_vel - dw * yaw_vel) / dr;
+}
+
+/**
+ * @brief Returns right wheel ground velocity [rad/s]
+ */
+float Plant::get_velocity_R()
+{
+	return (lin_vel + dw * yaw_vel) / dr;
+}
+
+/**
+ * @brief Returns zero-mean Gaussian noise sample with given std
+ */
+float Plant::noise(float std)
+{
+	std::normal_distribution<float> dist_n(0.0f, std);
+	return dist_n(rng);
+}
\ No newline at end of file
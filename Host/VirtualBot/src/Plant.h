@@ -0,0 +1,25 @@
+/**
+ * @file Plant.h
+ * @brief Simulated balancing robot dynamics
+ * @author agent
+ */
+#pragma once
+
+/**
+ * Namespace Declaration
+ */
+namespace Plant
+{
+	void init(float pitch_init, float v_bat, unsigned seed);
+	void step(float t);
+	void set_voltages(float v_L, float v_R);
+	float get_v_bat();
+	float get_pitch();
+	float get_pitch_vel();
+	float get_yaw_vel();
+	float get_angle_L();
+	float get_angle_R();
+	float get_velocity_L();
+	float get_velocity_R();
+	float noise(float std);
+}
\ No newline at end of file
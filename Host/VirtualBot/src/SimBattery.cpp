@@ -0,0 +1,50 @@
+/**
+ * @file SimBattery.cpp
+ * @brief Simulated Battery subsystem backed by Plant
+ * @author agent
+ */
+#include <Battery.h>
+#include <MotorConfig.h>
+#include "Plant.h"
+using MotorConfig::Vb;
+
+/**
+ * Namespace Definitions
+ */
+namespace Battery
+{
+	const float v_low = 10.0f;	// Undervoltage threshold [V]
+}
+
+void Battery::init() {}
+void Battery::update() {}
+
+float Battery::get_voltage()
+{
+	return Plant::get_v_bat();
+}
+
+float Battery::get_v_limit()
+{
+	return Plant::get_v_bat();
+}
+
+float Battery::to_v_limit(float v_bat)
+{
+	return v_bat;
+}
+
+float Battery::get_duty_scale()
+{
+	return Vb / Plant::get_v_bat();
+}
+
+bool Battery::is_undervolt()
+{
+	return Plant::get_v_bat() < v_low;
+}
+
+bool Battery::has_sensor()
+{
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+/**
+ * @file SimDiagnostics.cpp
+ * @brief Simulated Diagnostics subsystem (always balancing)
+ * @author agent
+ * 
+ * Diagnostic modes drive hardware directly, so mode commands from the
+ * Bluetooth protocol are accepted and ignored.
+ */
+#include <Diagnostics.h>
+
+void Diagnostics::set_mode(uint8_t) {}
\ No newline at end of file
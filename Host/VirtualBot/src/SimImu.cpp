@@ -0,0 +1,68 @@
+/**
+ * @file SimImu.cpp
+ * @brief Simulated Imu subsystem backed by Plant
+ * @author agent
+ */
+#include <Imu.h>
+#include "Plant.h"
+
+/**
+ * Namespace Definitions
+ */
+namespace Imu
+{
+	// Estimate Noise
+	const float pitch_std = 0.002f;		// Pitch noise [rad]
+	const float gyr_std = 0.003f;		// Gyro noise [rad/s]
+
+	// State Variables
+	float pitch = 0.0f;
+	float pitch_vel = 0.0f;
+	float yaw_vel = 0.0f;
+}
+
+void Imu::init() {}
+
+/**
+ * @brief Samples noisy plant state as IMU estimates
+ */
+void Imu::update()
+{
+	pitch = Plant::get_pitch() + Plant::noise(pitch_std);
+	pitch_vel = Plant::get_pitch_vel() + Plant::noise(gyr_std);
+	yaw_vel = Plant::get_yaw_vel() + Plant::noise(gyr_std);
+}
+
+void Imu::process(float, float, float, float, float, float, float, uint8_t) {}
+void Imu::reset() {}
+void Imu::calibrate() {}
+
+float Imu::get_pitch()
+{
+	return pitch;
+}
+
+float Imu::get_pitch_vel()
+{
+	return pitch_vel;
+}
+
+float Imu::get_yaw_vel()
+{
+	return yaw_vel;
+}
+
+bool Imu::is_ok()
+{
+	return true;
+}
+
+uint16_t Imu::get_fault_count()
+{
+	return 0;
+}
+
+uint32_t Imu::get_recovery_time()
+{
+	return 0;
+}
\ No newline at end of file
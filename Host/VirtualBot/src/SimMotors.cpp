@@ -0,0 +1,90 @@
+/**
+ * @file SimMotors.cpp
+ * @brief Simulated MotorL and MotorR subsystems backed by Plant
+ * @author agent
+ */
+#include <MotorL.h>
+#include <MotorR.h>
+#include "Plant.h"
+
+/**
+ * Namespace Definitions
+ */
+namespace MotorL
+{
+	float angle = 0.0f;		// Wheel angle [rad]
+	float velocity = 0.0f;	// Wheel velocity [rad/s]
+	float v_cmd = 0.0f;		// Voltage command [V]
+}
+namespace MotorR
+{
+	float angle = 0.0f;		// Wheel angle [rad]
+	float velocity = 0.0f;	// Wheel velocity [rad/s]
+	float v_cmd = 0.0f;		// Voltage command [V]
+}
+
+void MotorL::init() {}
+void MotorL::latch() {}
+void MotorL::process(float) {}
+void MotorL::reset() {}
+
+/**
+ * @brief Samples left wheel state from plant
+ */
+void MotorL::update()
+{
+	angle = Plant::get_angle_L();
+	velocity = Plant::get_velocity_L();
+}
+
+/**
+ * @brief Sends left voltage command to plant
+ */
+void MotorL::set_voltage(float v)
+{
+	v_cmd = v;
+	Plant::set_voltages(MotorL::v_cmd, MotorR::v_cmd);
+}
+
+float MotorL::get_angle()
+{
+	return angle;
+}
+
+float MotorL::get_velocity()
+{
+	return velocity;
+}
+
+void MotorR::init() {}
+void MotorR::latch() {}
+void MotorR::process(float) {}
+void MotorR::reset() {}
+
+/**
+ * @brief Samples right wheel state from plant
+ */
+void MotorR::update()
+{
+	angle = Plant::get_angle_R();
+	velocity = Plant::get_velocity_R();
+}
+
+/**
+ * @brief Sends right voltage command to plant
+ */
+void MotorR::set_voltage(float v)
+{
+	v_cmd = v;
+	Plant::set_voltages(MotorL::v_cmd, MotorR::v_cmd);
+}
+
+float MotorR::get_angle()
+{
+	return angle;
+}
+
+float MotorR::get_velocity()
+{
+	return velocity;
+}
\ No newline at end of file
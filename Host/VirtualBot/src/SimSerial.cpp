@@ -0,0 +1,47 @@
+/**
+ * @file SimSerial.cpp
+ * @brief Simulated robot UART backing the firmware Serial port
+ * @author agent
+ */
+#include "SimSerial.h"
+#include <Arduino.h>
+
+/**
+ * Namespace Definitions
+ */
+namespace SimSerial
+{
+	const uint8_t rx_size = 64;
+	std::deque<uint8_t> rx;
+	std::deque<uint8_t> tx;
+}
+
+/**
+ * @brief Adds received byte to RX buffer (dropped if full, like the UART)
+ */
+void SimSerial::receive(uint8_t byte)
+{
+	if (rx.size() < rx_size) rx.push_back(byte);
+}
+
+/**
+ * Firmware Serial port over SimSerial buffers
+ */
+HardwareSerial Serial;
+void HardwareSerial::begin(unsigned long) {}
+int HardwareSerial::available() { return SimSerial::rx.size(); }
+void HardwareSerial::flush() {}
+
+int HardwareSerial::read()
+{
+	if (SimSerial::rx.empty()) return -1;
+	const uint8_t byte = SimSerial::rx.front();
+	SimSerial::rx.pop_front();
+	return byte;
+}
+
+size_t HardwareSerial::write(uint8_t byte)
+{
+	SimSerial::tx.push_back(byte);
+	return 1;
+}
\ No newline at end of file
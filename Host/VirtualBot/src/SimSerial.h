@@ -0,0 +1,22 @@
+/**
+ * @file SimSerial.h
+ * @brief Simulated robot UART buffers
+ * @author agent
+ */
+#pragma once
+#include <stdint.h>
+#include <deque>
+
+/**
+ * Namespace Declaration
+ */
+namespace SimSerial
+{
+	// Fields
+	extern const uint8_t rx_size;		// RX buffer size [bytes]
+	extern std::deque<uint8_t> rx;		// Received bytes
+	extern std::deque<uint8_t> tx;		// Bytes to transmit
+
+	// Methods
+	void receive(uint8_t byte);
+}
\ No newline at end of file
@@ -0,0 +1,290 @@
+/**
+ * @file main.cpp
+ * @brief Virtual BalBot serial endpoints for host tool testing
+ * @author agent
+ * 
+ * Runs the firmware Trajectory, Controller and Odometry subsystems against
+ * a simulated plant, and serves each virtual robot on a Linux
+ * pseudo-terminal that speaks the Bluetooth wire format. Each robot is a
+ * separate process, since firmware subsystems keep global state.
+ * 
+ * Usage: program [options]
+ *   -n, --robots N      Number of virtual robots [1]
+ *   -d, --dir DIR       Directory for balbot<i> pty symlinks [/tmp]
+ *   -l, --latency MS    Fixed one-way link latency [0 ms]
+ *   -j, --jitter MS     Max random extra latency [0 ms]
+ *   -p, --loss P        Byte loss probability [0]
+ *   -b, --baud BAUD     Link baud rate [57600]
+ *   -v, --vbat V        Battery voltage [12 V]
+ *   -s, --seed SEED     Random seed [0]
+ *   -r, --record FILE   Record robot 0 trace inputs to FILE [off]
+ * 
+ * Recorded inputs are the IMU and encoder readings the plant would give
+ * the real firmware, in the 13-column trace format of Host/TraceTest (add
+ * them as a golden trace with its --add option).
+ */
+#include <Imu.h>
+#include <MotorL.h>
+#include <MotorR.h>
+#include <Battery.h>
+#include <Bluetooth.h>
+#include <Trajectory.h>
+#include <Controller.h>
+#include <Odometry.h>
+#include <MotorConfig.h>
+#include "Plant.h"
+#include "Link.h"
+#include "SimSerial.h"
+#include <fcntl.h>
+#include <getopt.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <random>
+#include <string>
+using Controller::t_ctrl;
+
+/**
+ * Virtual robot options
+ */
+struct Options
+{
+	int robots = 1;				// Number of robots
+	std::string dir = "/tmp";	// Symlink directory
+	float latency = 0.0f;		// Link latency [s]
+	float jitter = 0.0f;		// Link jitter [s]
+	float loss = 0.0f;			// Byte loss probability
+	uint32_t baud = 57600;		// Link baud rate
+	float v_bat = 12.0f;		// Battery voltage [V]
+	unsigned seed = 0;			// Random seed
+	std::string record;			// Trace record file
+};
+
+// Timing Constants
+const double t_link = 0.001;			// Link service period [s]
+const int link_per_ctrl = 10;			// Link periods per control period
+const float pitch_init = 0.02f;			// Initial pitch [rad]
+
+// Recorded Sensor Noise
+const float g = 9.81f;					// Gravity [m/s^2]
+const float acc_std = 0.05f;			// Accel noise [m/s^2]
+const float gyr_std = 0.003f;			// Gyro noise [rad/s]
+
+/**
+ * @brief Returns monotonic time [s]
+ */
+double now()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/**
+ * @brief Runs one control period of the firmware loop
+ */
+void run_firmware()
+{
+	Imu::update();
+	MotorL::update();
+	MotorR::update();
+	Battery::update();
+	Trajectory::update();
+	Controller::update();
+	MotorL::set_voltage(Controller::get_motor_L_cmd());
+	MotorR::set_voltage(Controller::get_motor_R_cmd());
+	Odometry::update();
+	Bluetooth::update();
+}
+
+/**
+ * @brief Writes one control period of trace inputs from plant state
+ * @param file Record file
+ * @param rng Sensor noise generator
+ * 
+ * Single-reading IMU path (n = 1, t_int = t_ctrl), with yaw velocity split
+ * over the gyro axes and encoder angles including pitch, as the firmware
+ * Imu and MotorL/R process functions expect.
+ */
+void record_inputs(FILE* file, std::mt19937& rng)
+{
+	std::normal_distribution<float> acc_n(0.0f, acc_std);
+	std::normal_distribution<float> gyr_n(0.0f, gyr_std);
+	const float pitch = Plant::get_pitch();
+	const float gyr_x = Plant::get_pitch_vel() + gyr_n(rng);
+	const float yaw_vel = Plant::get_yaw_vel();
+	const float dir = MotorConfig::direction;
+	fprintf(file, "%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,1,%.9g,%.9g,%.9g,%.9g,%.9g\n",
+		g * sinf(pitch) + acc_n(rng),
+		g * cosf(pitch) + acc_n(rng),
+		gyr_x,
+		gyr_x,
+		yaw_vel * sinf(pitch) + gyr_n(rng),
+		yaw_vel * cosf(pitch) + gyr_n(rng),
+		t_ctrl,
+		dir * (Plant::get_angle_L() + pitch),
+		dir * (Plant::get_angle_R() + pitch),
+		Trajectory::get_lin_vel_cmd(),
+		Trajectory::get_yaw_vel_cmd(),
+		Plant::get_v_bat());
+	fflush(file);
+}
+
+/**
+ * @brief Runs virtual robot on a new pseudo-terminal (never returns)
+ * @param id Robot index
+ * @param opt Options
+ */
+void run_robot(int id, const Options& opt)
+{
+	// Open pseudo-terminal in raw mode
+	const int master = posix_openpt(O_RDWR | O_NOCTTY);
+	if (master < 0 || grantpt(master) || unlockpt(master))
+	{
+		perror("posix_openpt");
+		exit(1);
+	}
+	const char* slave_name = ptsname(master);
+	termios tio;
+	tcgetattr(master, &tio);
+	cfmakeraw(&tio);
+	tcsetattr(master, TCSANOW, &tio);
+	fcntl(master, F_SETFL, O_NONBLOCK);
+
+	// Hold slave open so reads do not fail between client connections
+	const int slave = open(slave_name, O_RDWR | O_NOCTTY);
+	(void)slave;
+
+	// Symlink for stable client paths
+	const std::string link_path = opt.dir + "/balbot" + std::to_string(id);
+	unlink(link_path.c_str());
+	if (symlink(slave_name, link_path.c_str()) != 0) perror("symlink");
+	printf("Robot %d: %s -> %s\n", id, link_path.c_str(), slave_name);
+	fflush(stdout);
+
+	// Init plant, links and firmware
+	const unsigned seed = opt.seed + 3 * id;
+	Plant::init(pitch_init, opt.v_bat, seed);
+	Link link_rx(opt.latency, opt.jitter, opt.loss, opt.baud, seed + 1);
+	Link link_tx(opt.latency, opt.jitter, opt.loss, opt.baud, seed + 2);
+	Bluetooth::init();
+	Imu::init();
+	MotorL::init();
+	MotorR::init();
+	Battery::init();
+	Trajectory::init();
+	Controller::init();
+	Odometry::init();
+
+	// Open trace record file
+	FILE* rec_file = nullptr;
+	std::mt19937 rec_rng(seed + 4);
+	if (id == 0 && !opt.record.empty())
+	{
+		rec_file = fopen(opt.record.c_str(), "w");
+		if (!rec_file) perror("fopen");
+		else fprintf(rec_file, "acc_y,acc_z,gyr_x,gyr_x_new,gyr_y,gyr_z,t_int,n,"
+			"angle_L,angle_R,lin_vel_cmd,yaw_vel_cmd,v_bat\n");
+	}
+
+	// Real-time loop
+	double t_next = now();
+	for (int link_count = 0; ; link_count++)
+	{
+		const double t = now();
+
+		// Host to robot
+		uint8_t buf[256];
+		const ssize_t n = read(master, buf, sizeof(buf));
+		for (ssize_t i = 0; i < n; i++) link_rx.push(buf[i], t);
+		uint8_t byte;
+		while (link_rx.pop(byte, t)) SimSerial::receive(byte);
+
+		// Control period
+		if (link_count % link_per_ctrl == 0)
+		{
+			Plant::step(t_ctrl);
+			run_firmware();
+			if (rec_file) record_inputs(rec_file, rec_rng);
+		}
+
+		// Robot to host
+		while (!SimSerial::tx.empty())
+		{
+			link_tx.push(SimSerial::tx.front(), t);
+			SimSerial::tx.pop_front();
+		}
+		while (link_tx.pop(byte, t))
+		{
+			if (write(master, &byte, 1) != 1) break;
+		}
+
+		// Wait for next link period
+		t_next += t_link;
+		const double t_sleep = t_next - now();
+		if (t_sleep > 0.0) usleep((useconds_t)(1e6 * t_sleep));
+	}
+}
+
+/**
+ * @brief Parses options and forks virtual robots
+ */
+int main(int argc, char** argv)
+{
+	// Parse options
+	Options opt;
+	const option long_opts[] =
+	{
+		{"robots", required_argument, nullptr, 'n'},
+		{"dir", required_argument, nullptr, 'd'},
+		{"latency", required_argument, nullptr, 'l'},
+		{"jitter", required_argument, nullptr, 'j'},
+		{"loss", required_argument, nullptr, 'p'},
+		{"baud", required_argument, nullptr, 'b'},
+		{"vbat", required_argument, nullptr, 'v'},
+		{"seed", required_argument, nullptr, 's'},
+		{"record", required_argument, nullptr, 'r'},
+		{nullptr, 0, nullptr, 0}
+	};
+	int c;
+	while ((c = getopt_long(argc, argv, "n:d:l:j:p:b:v:s:r:", long_opts, nullptr)) != -1)
+	{
+		switch (c)
+		{
+			case 'n': opt.robots = atoi(optarg); break;
+			case 'd': opt.dir = optarg; break;
+			case 'l': opt.latency = 1e-3f * atof(optarg); break;
+			case 'j': opt.jitter = 1e-3f * atof(optarg); break;
+			case 'p': opt.loss = atof(optarg); break;
+			case 'b': opt.baud = atoi(optarg); break;
+			case 'v': opt.v_bat = atof(optarg); break;
+			case 's': opt.seed = atoi(optarg); break;
+			case 'r': opt.record = optarg; break;
+			default:
+				fprintf(stderr, "See main.cpp header for usage.\n");
+				return 1;
+		}
+	}
+
+	// Fork one process per robot
+	for (int id = 0; id < opt.robots; id++)
+	{
+		const pid_t pid = fork();
+		if (pid == 0) run_robot(id, opt);
+		if (pid < 0)
+		{
+			perror("fork");
+			return 1;
+		}
+	}
+
+	// Wait for robots (Ctrl+C stops the process group)
+	while (wait(nullptr) > 0);
+	return 0;
+}
\ No newline at end of file
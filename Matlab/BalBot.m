@@ -3,31 +3,35 @@ classdef BalBot < handle
     %   
     %   Author: Dan Oates (WPI Class of 2020)
     
-    properties (SetAccess = protected)
-        lin_vel_lim;    % Linear velocity limiter [controls.ClampLimiter]
-        lin_acc_lim;    % Linear acceleration limiter [controls.SlewLimiter]
-        yaw_vel_lim;    % Yaw velocity limiter [controls.ClampLimiter]
-    end
-    
     properties (Access = protected)
         serial_;    % Embedded serial interface [serial_com.SerialStruct]
     end
     
+    properties (Constant, Access = protected)
+        modes = {...    % Diagnostic mode names [index = mode ID + 1]
+            'balance', ...
+            'serial_debug', ...
+            'motor_speed_test', ...
+            'get_max_ctrl_freq', ...
+            'calibrate_imu', ...
+            'trace', ...
+            'sysid', ...
+            'calibrate_motors'};
+    end
+    
+    properties (Constant)
+        sysid_n = 1500; % System ID samples [see Diagnostics.cpp]
+    end
+    
     methods (Access = public)
-        function obj = BalBot(bot_name, lin_vel_max, lin_acc_max, yaw_vel_max)
-            %obj = BALBOT(bot_name, lin_vel_max, lin_acc_max, yaw_vel_max)
+        function obj = BalBot(bot_name)
+            %obj = BALBOT(bot_name)
             %   Construct robot interface
             %   
             %   Inputs:
             %   - bot_name = Bluetooth name [ex. 'ES3011_BOT01']
-            %   - lin_vel_max = Max linear velocity command [m/s]
-            %   - lin_acc_max = Max linear acceleration command [m/s^2]
-            %   - yaw_vel_max = Max yaw velocity command [rad/s]
             serial_ = serial_com.make_bluetooth(bot_name);
             obj.serial_ = serial_com.SerialStruct(serial_);
-            obj.lin_vel_lim = controls.ClampLimiter(lin_vel_max);
-            obj.lin_acc_lim = controls.SlewLimiter(lin_acc_max);
-            obj.yaw_vel_lim = controls.ClampLimiter(yaw_vel_max);
         end
         
         function state = send_cmds(obj, lin_vel_cmd, yaw_vel_cmd)
@@ -38,31 +42,114 @@ classdef BalBot < handle
             %   - lin_vel_cmd = Linear velocity [m/s]
             %   - yaw_vel_cmd = Yaw velocity [rad/s]
             %   
+            %   Commands are sent unshaped. The robot caps them and limits
+            %   their acceleration and jerk [see Trajectory.cpp].
+            %   
             %   Outputs:
-            %   - state.lin_vel_cmd = Limited linear velocity [m/s]
-            %   - state.yaw_vel_cmd = Limited yaw velocity [rad/s]
+            %   - state.lin_vel_cmd = Sent linear velocity [m/s]
+            %   - state.yaw_vel_cmd = Sent yaw velocity [rad/s]
             %   - state.lin_vel = Robot linear velocity [m/s]
             %   - state.yaw_vel = Robot yaw velocity [rad/s]
             %   - state.volts_L = Left motor voltage [V]
             %   - state.volts_R = Right motor voltage [V]
+            %   - state.x = Odometry X position [m]
+            %   - state.y = Odometry Y position [m]
+            %   - state.heading = Odometry heading [rad]
+            %   - state.v_bat = Battery voltage [V]
+            %   - state.undervolt = Battery undervoltage flag [logical]
+            %   - state.imu_fault = IMU fault recovery flag [logical]
+            %   - state.no_bat_sense = Battery reading implausible [logical]
+            %   - state.imu_faults = IMU faults since boot [saturates at 255]
+            %   - state.imu_recovery = Last IMU recovery time [ms, saturates at 255]
             
-            % Filter input commands
-            lin_vel_cmd = obj.lin_vel_lim.update(lin_vel_cmd);
-            lin_vel_cmd = obj.lin_acc_lim.update(lin_vel_cmd);
-            yaw_vel_cmd = obj.yaw_vel_lim.update(yaw_vel_cmd);
-            
-            % Send filtered commands
+            % Send commands
             obj.serial_.write(lin_vel_cmd, 'single');
             obj.serial_.write(yaw_vel_cmd, 'single');
             
             % Get state from robot
-            state = struct();
+            state = obj.read_state();
             state.lin_vel_cmd = lin_vel_cmd;
             state.yaw_vel_cmd = yaw_vel_cmd;
-            state.lin_vel = obj.serial_.read('single');
-            state.yaw_vel = obj.serial_.read('single');
-            state.volts_L = obj.serial_.read('single');
-            state.volts_R = obj.serial_.read('single');
+        end
+        
+        function reset_odom(obj)
+            %RESET_ODOM(obj) Reset robot odometry pose to origin
+            obj.send_cmd(16);
+        end
+        
+        function set_mode(obj, mode)
+            %SET_MODE(obj, mode)
+            %   Select diagnostic mode on robot
+            %   
+            %   Inputs:
+            %   - mode = Mode name [see BalBot.modes]
+            %   
+            %   Modes other than 'balance' print text to the robot serial
+            %   port, so send_cmds replies are invalid until the robot
+            %   returns to 'balance'.
+            mode_id = find(strcmp(obj.modes, mode), 1) - 1;
+            if isempty(mode_id)
+                error('Invalid mode: %s', mode)
+            end
+            obj.send_cmd(mode_id);
+        end
+        
+        function [outputs, times] = trace(obj, inputs)
+            %[outputs, times] = TRACE(obj, inputs)
+            %   Replay input trace through robot estimator and controller
+            %   
+            %   Inputs:
+            %   - inputs = Input samples [n x 13]
+            %       [acc_y, acc_z, gyr_x, gyr_x_new, gyr_y, gyr_z, t_int, n, ...
+            %        angle_L, angle_R, lin_vel_cmd, yaw_vel_cmd, v_bat]
+            %   
+            %   Outputs:
+            %   - outputs = Output samples [n x 7]
+            %       [pitch, pitch_vel, yaw_vel, vel_L, vel_R, ...
+            %        volts_L, volts_R]
+            %   - times = Call times [us] [n x 3]
+            %       [Imu, MotorL + MotorR, Controller]
+            %   
+            %   Robot state is reset before and after the trace.
+            obj.set_mode('trace');
+            [n, n_in] = size(inputs);
+            outputs = zeros(n, 7);
+            times = zeros(n, 3);
+            for i = 1:n
+                for j = 1:n_in
+                    obj.serial_.write(inputs(i, j), 'single');
+                end
+                for j = 1:7
+                    outputs(i, j) = obj.serial_.read('single');
+                end
+                for j = 1:3
+                    times(i, j) = obj.serial_.read('single');
+                end
+            end
+            
+            % End trace
+            for j = 1:n_in
+                obj.serial_.write(NaN, 'single');
+            end
+        end
+        
+        function data = sysid(obj)
+            %data = SYSID(obj)
+            %   Run motor system identification on robot
+            %   
+            %   Outputs:
+            %   - data = Samples at control rate [n x 4]
+            %       [volts, vel_L, vel_R, v_bat]
+            %   
+            %   Robot must be on a stand with the wheels free. Motors are
+            %   driven with a PRBS voltage for n control periods.
+            obj.set_mode('sysid');
+            data = zeros(obj.sysid_n, 4);
+            for i = 1:obj.sysid_n
+                for j = 1:4
+                    data(i, j) = obj.serial_.read('single');
+                end
+            end
         end
         
         function delete(obj)
@@ -70,4 +157,37 @@ classdef BalBot < handle
             fclose(obj.serial_.get_serial());
         end
     end
+    
+    methods (Access = protected)
+        function send_cmd(obj, cmd_id)
+            %SEND_CMD(obj, cmd_id)
+            %   Send command packet and discard state reply
+            %   
+            %   Inputs:
+            %   - cmd_id = Command ID [0x00-0x0F = mode, 0x10 = reset odom]
+            obj.serial_.write(NaN, 'single');
+            obj.serial_.write(cmd_id, 'single');
+            obj.read_state();
+        end
+        
+        function state = read_state(obj)
+            %state = READ_STATE(obj)
+            %   Read state reply from robot
+            state = struct();
+            state.lin_vel = obj.serial_.read('single');
+            state.yaw_vel = obj.serial_.read('single');
+            state.volts_L = obj.serial_.read('single');
+            state.volts_R = obj.serial_.read('single');
+            state.x = double(obj.serial_.read('int16')) / 1000;
+            state.y = double(obj.serial_.read('int16')) / 1000;
+            state.heading = double(obj.serial_.read('int16')) / 10000;
+            state.v_bat = double(obj.serial_.read('uint8')) / 10;
+            flags = obj.serial_.read('uint8');
+            state.undervolt = bitand(flags, 1) ~= 0;
+            state.imu_fault = bitand(flags, 2) ~= 0;
+            state.no_bat_sense = bitand(flags, 4) ~= 0;
+            state.imu_faults = double(obj.serial_.read('uint8'));
+            state.imu_recovery = double(obj.serial_.read('uint8'));
+        end
+    end
 end
\ No newline at end of file
@@ -0,0 +1,159 @@
+function tables = balbot_empc(N)
+%tables = BALBOT_EMPC(N)
+%   Generate explicit constrained balance controller tables
+%   
+%   Inputs:
+%   - N = MPC horizon [control periods] (default 50)
+%   
+%   Outputs:
+%   - tables = Correction tables [mV] {tr = 30, tr = 56}
+%   
+%   Solves a voltage-constrained MPC offline at every point of a (pitch,
+%   pitch_vel, vel_err) grid using the balance model from Controller.cpp:
+%   
+%       Mx * pitch'' = Tg * pitch + tau
+%       My * vel' = tau
+%       tau = Gt * (V - Gv * vel)
+%   
+%   The input u = V - Gv * vel_cmd is the voltage above the velocity
+%   feedforward, so the motor limit |V| <= Vb holds for |u| <= Vb - |Gv *
+%   vel_cmd|. The table is solved at vel_cmd = 0, where the box is
+%   |u| <= Vb. The model is linear, so Controller.cpp rescales the table to
+%   the headroom left by the feedforward and battery sag at run time.
+%   
+%   The MPC cost is the sum of squared deviations from the ss_K* pole
+%   placement law over the horizon, which is the cost for which that law is
+%   LQ-optimal. The MPC therefore matches the linear law wherever no limit
+%   is hit, and the table stores only the difference between the first MPC
+%   move and the clamped linear law.
+%   
+%   The difference is confined to a thin band of states just inside the
+%   limits, so the grid is over (pitch, pitch_vel, u_lin) with u_lin = -K*x
+%   rather than vel_err. The u_lin range ends 1 V past Vb, where the
+%   difference is zero, and only pitch >= 0 is stored since the solution is
+%   odd. Prints CtrlTable code for both torque ratios. Requires the
+%   Optimization Toolbox (quadprog). Host/CtrlTableGen solves the same
+%   problem without it and generated the committed tables.
+clc;
+
+% Default arguments
+if nargin < 1, N = 50; end
+
+% Constants
+t_ctrl = 0.01;  % Control period [s]
+Vb = 12.0;      % Nominal battery voltage [V]
+i_NL = 0.12;    % No-load current [A]
+R = 5.4;        % Resistance [Ohm]
+Ix = 0.00215;   % Pitch inertia [kg*m^2]
+m = 0.955;      % Robot mass [kg]
+g = 9.81;       % Gravity [m/s^2]
+dg = 0.062;     % CG height [m]
+dr = 0.034;     % Wheel radius [m]
+px = 20.0;      % Pitch-velocity pole [1/s]
+vel_cmd = 0.0;  % Table velocity command [m/s]
+
+% Grid [see CtrlTable.cpp]
+pitch = linspace(0.0, 0.8, 5);
+pitch_vel = linspace(-10.0, 10.0, 11);
+u_lin = linspace(-13.0, 13.0, 27);
+
+% Generate table for each torque ratio
+fprintf('Balancing Robot Explicit MPC Generator\n')
+trs = [30, 56];
+tables = cell(1, 2);
+opts = optimoptions('quadprog', 'Display', 'off');
+for t = 1:2
+    % Motor constants [see MotorConfig.cpp]
+    tr = trs(t);
+    w_NL = 1047 / tr;
+    t_ST = 0.015 * tr;
+    Kv = (Vb - R * i_NL) / w_NL;
+    Kt = t_ST * R / Vb;
+
+    % Discrete model with state [pitch; pitch_vel; vel_err]
+    % Input is voltage above velocity feedforward
+    Mx = Ix * dr / dg;
+    My = m * dr;
+    Tg = m * g * dr;
+    Gt = 2 * Kt / R;
+    Gv = Kv / dr;
+    Ac = [0, 1, 0; Tg/Mx, 0, Gt*Gv/Mx; 0, 0, -Gt*Gv/My];
+    Bc = [0; Gt/Mx; -Gt/My];
+    Md = expm([Ac, Bc; zeros(1, 4)] * t_ctrl);
+    A = Md(1:3, 1:3);
+    B = Md(1:3, 4);
+
+    % Pole placement law u = -K * x [see Controller.cpp]
+    K = [3*Mx/Gt*px^2 + Tg/Gt, ...
+        Mx^2/(Gt*Tg)*px^3 + 3*Mx/Gt*px, ...
+        Mx*My/(Gt*Tg)*px^3 + Gv];
+
+    % Law deviations over horizon: d = G * U + D * x0
+    G = eye(N);
+    D = zeros(N, 3);
+    Phi = eye(3);
+    Gam = zeros(3, N);
+    for k = 1:N
+        G(k, :) = G(k, :) + K * Gam;
+        D(k, :) = K * Phi;
+        Gam = A * Gam;
+        Gam(:, k) = Gam(:, k) + B;
+        Phi = A * Phi;
+    end
+    H = G' * G;
+    H = 0.5 * (H + H');
+
+    % Voltage limit on feedforward plus input: |Gv * cmd + u| <= Vb
+    v_ref = Gv * vel_cmd;
+    lb = (-Vb - v_ref) * ones(N, 1);
+    ub = (+Vb - v_ref) * ones(N, 1);
+
+    % Solve MPC at grid points
+    fprintf('\nSolving %u grid points (tr = %u) ...\n', ...
+        numel(pitch) * numel(pitch_vel) * numel(u_lin), tr)
+    table = zeros(numel(u_lin), numel(pitch_vel), numel(pitch));
+    for i = 1:numel(pitch)
+        for j = 1:numel(pitch_vel)
+            for k = 1:numel(u_lin)
+                vel_err = -(u_lin(k) + K(1) * pitch(i) + K(2) * pitch_vel(j)) / K(3);
+                x0 = [pitch(i); pitch_vel(j); vel_err];
+                U = quadprog(H, G' * D * x0, [], [], [], [], lb, ub, [], opts);
+                u_clamp = min(max(u_lin(k), lb(1)), ub(1));
+                table(k, j, i) = round(1000 * (U(1) - u_clamp));
+            end
+        end
+    end
+
+    % Make pitch = 0 plane exactly odd (CtrlTable mirrors negative pitch)
+    plane = table(:, :, 1);
+    table(:, :, 1) = fix((plane - rot90(plane, 2)) / 2);
+    if any(table([1, end], :, :) ~= 0, 'all')
+        error('Correction non-zero at u_lin range ends, extend range.')
+    end
+    tables{t} = table;
+    fprintf('Non-zero entries: %u of %u\n', nnz(table), numel(table))
+
+    % Print CtrlTable code (one row per pitch and pitch_vel point)
+    fprintf('\nCtrlTable Code (tr = %u):\n', tr)
+    if nnz(table) == 0
+        fprintf('const bool has_table = false;\n')
+        fprintf('const int16_t table[1] PROGMEM = {0};\n')
+        continue
+    end
+    fprintf('const bool has_table = true;\n')
+    fprintf('const int16_t table[] PROGMEM =\n{\n')
+    for i = 1:numel(pitch)
+        for j = 1:numel(pitch_vel)
+            row = sprintf('%d, ', table(:, j, i));
+            if i == numel(pitch) && j == numel(pitch_vel)
+                row = row(1:end-2);
+            else
+                row = row(1:end-1);
+            end
+            fprintf('\t%s\n', row)
+        end
+    end
+    fprintf('};\n')
+end
+
+end
\ No newline at end of file
@@ -0,0 +1,124 @@
+function params = balbot_sysid(bot_name, R, data_file)
+%params = BALBOT_SYSID(bot_name, R, data_file)
+%   Identify drive motor parameters of self-balancing robot
+%   
+%   Inputs:
+%   - bot_name = Bluetooth device name [ex. 'ES3011_BOT01']
+%   - R = Measured motor resistance [Ohm]
+%   - data_file = Saved sysid data file (optional, skips robot run)
+%   
+%   Outputs:
+%   - params = Struct array of fitted parameters [L, R motor]
+%       Kv = Voltage constant [V/(rad/s)]
+%       Kt = Torque constant [N*m/A]
+%       R = Resistance [Ohm]
+%       J = Effective wheel-side inertia [kg*m^2]
+%       tau_f = Coulomb friction torque [N*m]
+%       tau_m = Mechanical time constant [s]
+%       rms = RMS velocity residual [rad/s]
+%   
+%   Place the robot on a stand with the wheels free before running. The
+%   robot applies a PRBS voltage to both motors and streams the response.
+%   Each motor is fit by linear least squares to the discretised model:
+%   
+%       J * dw/dt = Kt/R * (V - Kv*w) - tau_f * sign(w)
+%   
+%   Only Kv and the ratios Kt/(R*J) and tau_f/J are observable without a
+%   current sensor, so R is taken as measured and Kt = Kv (SI units).
+clc, instrreset;
+
+% Default arguments
+if nargin < 1, bot_name = 'BalBot'; end
+if nargin < 2, R = 5.4; end
+if nargin < 3, data_file = ''; end
+
+% Constants
+t_ctrl = 0.01;  % Control period [s]
+Vb = 12.0;      % Nominal battery voltage [V]
+i_NL = 0.12;    % No-load current [A]
+
+% Get sysid data
+if isempty(data_file)
+    fprintf('Balancing Robot System Identification\n\n')
+    fprintf(['Connecting to robot ''' bot_name ''' ...\n'])
+    balbot = BalBot(bot_name);
+    fprintf('Running excitation (%.0f s) ...\n', BalBot.sysid_n * t_ctrl)
+    data = balbot.sysid();
+    delete(balbot);
+    data_file = sprintf('balbot_sysid_%s.mat', bot_name);
+    save(data_file, 'data');
+    fprintf('Data saved to ''%s''.\n', data_file)
+else
+    loaded = load(data_file, 'data');
+    data = loaded.data;
+end
+
+% Fit motors
+volts = data(:, 1);
+vels = data(:, 2:3);
+fits = cell(1, 2);
+for m = 1:2
+    fits{m} = fit_motor(volts, vels(:, m), R, t_ctrl);
+end
+params = [fits{:}];
+
+% Print results
+names = {'L', 'R'};
+for m = 1:2
+    p = params(m);
+    fprintf('\nMotor %s:\n', names{m})
+    fprintf('  Kv    = %.5f [V/(rad/s)]\n', p.Kv)
+    fprintf('  Kt    = %.5f [N*m/A]\n', p.Kt)
+    fprintf('  R     = %.3f [Ohm]\n', p.R)
+    fprintf('  J     = %.3e [kg*m^2]\n', p.J)
+    fprintf('  tau_f = %.4f [N*m]\n', p.tau_f)
+    fprintf('  tau_m = %.4f [s]\n', p.tau_m)
+    fprintf('  RMS   = %.3f [rad/s]\n', p.rms)
+end
+
+% Print MotorConfig code from mean of both motors
+% Robots without a fitted block keep the tr-derived defaults
+Kv = mean([params.Kv]);
+Kt = mean([params.Kt]);
+bot_id = sscanf(bot_name, 'ES3011_BOT%u');
+fprintf('\nMotorConfig Code (add above the defaults):\n')
+if isempty(bot_id)
+    fprintf('#elif ES3011_BOT_ID == N\n')
+else
+    fprintf('#elif ES3011_BOT_ID == %u\n', bot_id)
+end
+fprintf('\tconst float R = %.4ff;\n', R)
+fprintf('\tconst float w_NL = %.4ff;\n', (Vb - R * i_NL) / Kv)
+fprintf('\tconst float t_ST = %.4ff;\n', Kt * Vb / R)
+
+end
+
+function p = fit_motor(volts, vel, R, t_ctrl)
+%p = FIT_MOTOR(volts, vel, R, t_ctrl)
+%   Fit motor model to PRBS response by least squares
+%   
+%   Velocity samples are encoder differences over the previous period, so
+%   each velocity change spans half of two consecutive voltage commands.
+
+% Regression: dw = a*V - b*w - c*sign(w)
+k = (2:length(vel)-1)';
+dw = vel(k+1) - vel(k);
+v = 0.5 * (volts(k-1) + volts(k));
+w = vel(k);
+A = [v, -w, -sign(w)];
+theta = A \ dw;
+a = theta(1);
+b = theta(2);
+c = theta(3);
+
+% Physical parameters
+p = struct();
+p.Kv = b / a;
+p.Kt = p.Kv;
+p.R = R;
+p.J = t_ctrl * p.Kt / (R * a);
+p.tau_f = c * p.J / t_ctrl;
+p.tau_m = t_ctrl / b;
+p.rms = sqrt(mean((A * theta - dw).^2));
+
+end
\ No newline at end of file
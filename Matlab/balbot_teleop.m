@@ -2,25 +2,38 @@ function balbot_teleop(...
     bot_name, ...
     ctrl_type, ...
     lin_vel_max, ...
-    lin_acc_max, ...
     yaw_vel_max)
-%BALBOT_TELEOP(bot_name, ctrl_type, lin_vel_max, lin_acc_max, yaw_vel_max)
+%BALBOT_TELEOP(bot_name, ctrl_type, lin_vel_max, yaw_vel_max)
 %   Run bluetooth teleoperation of self-balancing robot
 %   
 %   Inputs:
 %   - bot_name = Bluetooth device name [ex. 'ES3011_BOT01']
 %   - ctrl_type = Controller type ['Xbox360', 'Nint64']
 %   - lin_vel_max = Max linear velocity command [m/s]
-%   - lin_acc_max = Max linear acceleration command [m/s^2]
 %   - yaw_vel_max = Max yaw velocity command [rad/s]
+%   
+%   Command shaping runs on the robot [see Trajectory.cpp], which caps
+%   commands at 0.8 m/s and 1.6 rad/s and limits acceleration to 0.8 m/s^2
+%   and 8 rad/s^2. Larger maxima are reduced to the caps.
 clc, instrreset;
 
 % Default arguments
 if nargin < 1, bot_name = 'BalBot'; end
 if nargin < 2, ctrl_type = 'Xbox360'; end
 if nargin < 3, lin_vel_max = 0.8; end
-if nargin < 4, lin_acc_max = 0.8; end
-if nargin < 5, yaw_vel_max = 1.6; end
+if nargin < 4, yaw_vel_max = 1.6; end
+
+% Robot command caps [see Trajectory.cpp]
+lin_vel_cap = 0.8;  % Max linear velocity [m/s]
+yaw_vel_cap = 1.6;  % Max yaw velocity [rad/s]
+if lin_vel_max > lin_vel_cap
+    warning('lin_vel_max reduced to robot cap %.1f m/s', lin_vel_cap)
+    lin_vel_max = lin_vel_cap;
+end
+if yaw_vel_max > yaw_vel_cap
+    warning('yaw_vel_max reduced to robot cap %.1f rad/s', yaw_vel_cap)
+    yaw_vel_max = yaw_vel_cap;
+end
 
 % Create game controller
 switch ctrl_type
@@ -33,7 +46,7 @@ ctrl.auto_dzs();
 % Connect to robot
 fprintf('Balancing Robot Controller\n\n')
 fprintf(['Connecting to robot ''' bot_name ''' ...\n'])
-balbot = BalBot(bot_name, lin_vel_max, lin_acc_max, yaw_vel_max);
+balbot = BalBot(bot_name);
 
 % Log vectors
 log_n = 10000;
@@ -78,6 +91,21 @@ while 1
         fprintf('Yaw vel: %+.2f [rad/s]\n', state.yaw_vel)
         fprintf('Voltage L: %+.1f [V]\n', state.volts_L)
         fprintf('Voltage R: %+.1f [V]\n', state.volts_R)
+        fprintf('Pose: (%+.2f, %+.2f) [m], %+.2f [rad]\n', ...
+            state.x, state.y, state.heading)
+        if state.no_bat_sense
+            fprintf('Battery: no sensor (nominal voltage assumed)\n')
+        else
+            fprintf('Battery: %.1f [V]\n', state.v_bat)
+        end
+        if state.undervolt
+            fprintf('WARNING: Battery undervoltage!\n')
+        end
+        fprintf('IMU faults: %u (last recovery %u [ms])\n', ...
+            state.imu_faults, state.imu_recovery)
+        if state.imu_fault
+            fprintf('WARNING: IMU recovering, motors disabled!\n')
+        end
 
         % Log state
         lin_vel(log_i) = state.lin_vel;
@@ -0,0 +1,129 @@
+function results = balbot_trace(bot_name, times_file, golden_dir)
+%results = BALBOT_TRACE(bot_name, times_file, golden_dir)
+%   On-robot golden-trace replay and timing check
+%   
+%   Inputs:
+%   - bot_name = Bluetooth device name [ex. 'ES3011_BOT01']
+%   - times_file = Baseline call time file [ex. 'balbot_times.mat']
+%   - golden_dir = Golden trace directory (default Host/TraceTest/golden/botNN)
+%   
+%   Outputs:
+%   - results = Struct array with per-trace results
+%   
+%   Numerical equivalence is tested on the host by Host/TraceTest, which
+%   owns the golden files. This replays the same golden inputs through the
+%   Imu, MotorL/R and Controller code on the robot, checks the outputs
+%   against the golden outputs within a per-signal tolerance, and compares
+%   the mean call times to the baseline times. If the times file does not
+%   exist, the call times are saved as the baseline. Run this before and
+%   after every performance change.
+%   
+%   Golden outputs depend on the robot's motor and IMU configs, so the set
+%   is chosen by the robot ID in bot_name. Every trace in the set, built-in
+%   or recorded, is checked against its golden outputs.
+clc, instrreset;
+
+% Default arguments
+if nargin < 1, bot_name = 'BalBot'; end
+if nargin < 2, times_file = 'balbot_times.mat'; end
+bot_id = sscanf(bot_name, 'ES3011_BOT%u');
+if nargin < 3
+    if isempty(bot_id)
+        error('Cannot get robot ID from ''%s'' [ex. ''ES3011_BOT01''].', bot_name)
+    end
+    golden_dir = fullfile(fileparts(mfilename('fullpath')), ...
+        '..', 'Host', 'TraceTest', 'golden', sprintf('bot%02u', bot_id));
+end
+if ~isfolder(golden_dir)
+    error(['No golden traces for robot in ''%s''. Generate them with ' ...
+        'Host/TraceTest built for its ES3011_BOT_ID.'], golden_dir)
+end
+
+% Signal names and tolerances [see Host/TraceTest]
+n_in = 13;
+out_names = {'pitch', 'pitch_vel', 'yaw_vel', ...
+    'vel_L', 'vel_R', 'volts_L', 'volts_R'};
+out_tols = [1e-4, 1e-4, 1e-4, 1e-3, 1e-3, 1e-3, 1e-3];
+time_names = {'Imu', 'MotorL/R', 'Controller'};
+
+% Load golden traces (built-in traces first, then recorded)
+files = dir(fullfile(golden_dir, '*.csv'));
+[~, names] = cellfun(@fileparts, {files.name}, 'UniformOutput', false);
+built_in = {'step', 'ramp', 'noise', 'fifo'};
+names = [built_in(ismember(built_in, names)), sort(setdiff(names, built_in))];
+if isempty(names)
+    error('No golden traces in ''%s''.', golden_dir)
+end
+traces = struct('name', names, 'inputs', [], 'golden', []);
+for i = 1:length(traces)
+    data = readmatrix(fullfile(golden_dir, [names{i} '.csv']));
+    traces(i).inputs = data(:, 1:n_in);
+    traces(i).golden = data(:, n_in+1:end);
+end
+
+% Replay traces on robot
+fprintf('Balancing Robot Golden Trace Test\n\n')
+fprintf(['Connecting to robot ''' bot_name ''' ...\n'])
+balbot = BalBot(bot_name);
+for i = 1:length(traces)
+    fprintf('Replaying trace ''%s'' ...\n', traces(i).name)
+    [traces(i).outputs, traces(i).times] = balbot.trace(traces(i).inputs);
+end
+delete(balbot);
+
+% Load or save baseline call times
+if isfile(times_file)
+    loaded = load(times_file, 'baseline');
+    baseline = loaded.baseline;
+else
+    baseline = struct('name', {traces.name}, 'times', {traces.times});
+    save(times_file, 'baseline');
+    fprintf('\nBaseline call times saved to ''%s''.\n', times_file)
+end
+
+% Compare to golden outputs and baseline times
+results = struct('name', {}, 'max_err', {}, 'pass', {}, 'speedup', {});
+all_pass = true;
+for i = 1:length(traces)
+    trace = traces(i);
+    fprintf('\nTrace ''%s'':\n', trace.name)
+    
+    % Numerical equivalence
+    max_err = max(abs(trace.outputs - trace.golden), [], 1);
+    max_err(isnan(max_err)) = inf;
+    pass = max_err <= out_tols;
+    all_pass = all_pass && all(pass);
+    for k = 1:length(out_names)
+        status = 'FAIL';
+        if pass(k), status = 'pass'; end
+        fprintf('  %-10s max err %.3e (tol %.0e) %s\n', ...
+            out_names{k}, max_err(k), out_tols(k), status)
+    end
+    
+    % Call time speedup
+    speedup = nan(1, length(time_names));
+    j = find(strcmp({baseline.name}, trace.name), 1);
+    if ~isempty(j)
+        speedup = mean(baseline(j).times, 1) ./ mean(trace.times, 1);
+        for k = 1:length(time_names)
+            fprintf('  %-10s %7.1f us (baseline %7.1f us) speedup %.2fx\n', ...
+                time_names{k}, mean(trace.times(:, k)), ...
+                mean(baseline(j).times(:, k)), speedup(k))
+        end
+    end
+    
+    % Log results
+    results(end+1).name = trace.name; %#ok<AGROW>
+    results(end).max_err = max_err;
+    results(end).pass = pass;
+    results(end).speedup = speedup;
+end
+
+% Summary
+if all_pass
+    fprintf('\nAll traces equivalent to golden traces.\n')
+else
+    fprintf('\nTraces NOT equivalent to golden traces.\n')
+end
+
+end
\ No newline at end of file